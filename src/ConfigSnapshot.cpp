@@ -0,0 +1,59 @@
+#include "ConfigSnapshot.h"
+
+// Конструктор
+ConfigSnapshot::ConfigSnapshot(ServoController* servoController, MotionScheduler* motionScheduler)
+  : _servoController(servoController),
+    _motionScheduler(motionScheduler),
+    _generation(0),
+    _budget(0),
+    _version(0),
+    _bootId(0) {
+}
+
+// Инициализация
+void ConfigSnapshot::begin(uint32_t bootId) {
+  _bootId = bootId;
+  _buffer.reset();
+}
+
+// Получение снимка; пересобирается только при изменении версии
+JsonSharedBuffer ConfigSnapshot::get() {
+  uint32_t generation = _servoController->getConfigGeneration();
+  uint16_t budget = _motionScheduler->getCurrentBudget();
+
+  if (_buffer && generation == _generation && budget == _budget) {
+    return _buffer;
+  }
+
+  JsonDocument doc;
+  JsonArray servos = doc["servos"].to<JsonArray>();
+
+  ServoConfig* configs = _servoController->getAllServoConfigs();
+  for (uint8_t i = 0; i < _servoController->getServoCount(); i++) {
+    JsonObject servo = servos.add<JsonObject>();
+    servo["index"] = i;
+    servo["name"] = configs[i].name.c_str();
+    servo["minPulse"] = configs[i].minPulse;
+    servo["maxPulse"] = configs[i].maxPulse;
+    servo["centerOffset"] = configs[i].centerOffset;
+    servo["loadClass"] = configs[i].loadClass;
+  }
+
+  doc["frequency"] = _servoController->getPWMFrequency();
+  doc["currentBudget"] = budget;
+  doc["generation"] = generation;
+
+  // Сериализация сразу в буфер, который затем разделяют все получатели
+  _buffer = serializeJsonBuffer(doc);
+  _generation = generation;
+  _budget = budget;
+  _version++;
+  _etag = "\"" + String(_bootId, HEX) + "-" + String(_version) + "\"";
+
+  return _buffer;
+}
+
+// ETag последнего снимка
+const String& ConfigSnapshot::getEtag() const {
+  return _etag;
+}
@@ -0,0 +1,37 @@
+#ifndef CONFIG_SNAPSHOT_H
+#define CONFIG_SNAPSHOT_H
+
+#include <Arduino.h>
+#include "ServoController.h"
+#include "MotionScheduler.h"
+#include "JsonBuffer.h"
+
+// Кэш сериализованной конфигурации для WebSocket и GET /api/config.
+// Снимок пересобирается, только когда изменилась версия конфигурации
+// сервоприводов или бюджет тока; при каждой пересборке меняется ETag.
+// Используется только из задачи AsyncTCP.
+class ConfigSnapshot {
+public:
+  ConfigSnapshot(ServoController* servoController, MotionScheduler* motionScheduler);
+
+  // Идентификатор загрузки делает ETag уникальным между перезагрузками
+  void begin(uint32_t bootId);
+
+  // Актуальный снимок (общий буфер для всех получателей)
+  JsonSharedBuffer get();
+
+  // ETag последнего снимка, возвращенного get()
+  const String& getEtag() const;
+
+private:
+  ServoController* _servoController;
+  MotionScheduler* _motionScheduler;
+  JsonSharedBuffer _buffer;
+  uint32_t _generation;
+  uint16_t _budget;
+  uint32_t _version;
+  uint32_t _bootId;
+  String _etag;
+};
+
+#endif // CONFIG_SNAPSHOT_H
@@ -0,0 +1,126 @@
+#include "FlightRecorder.h"
+#include <new>
+
+// Глобальный экземпляр журнала
+FlightRecorder flightRecorder;
+
+// Конструктор
+FlightRecorder::FlightRecorder() : _head(0) {
+  memset(_records, 0, sizeof(_records));
+}
+
+// Снимок текущего состояния кольца
+FlightLogSnapshot FlightRecorder::snapshot() const {
+  FlightLogSnapshot snap;
+  portENTER_CRITICAL(&_mux);
+  uint32_t head = _head;
+  portEXIT_CRITICAL(&_mux);
+
+  snap.count = head < FLIGHT_RECORDER_CAPACITY ? head : FLIGHT_RECORDER_CAPACITY;
+  snap.first = head - snap.count;
+  snap.timeUs = micros();
+  return snap;
+}
+
+// Размер выгрузки в байтах
+size_t FlightRecorder::dumpSize(const FlightLogSnapshot& snap) const {
+  return sizeof(FlightLogHeader) + (size_t)snap.count * sizeof(FlightRecord);
+}
+
+// Заполнение фрагмента выгрузки
+size_t FlightRecorder::read(const FlightLogSnapshot& snap, size_t offset,
+                            uint8_t* buffer, size_t maxLen) const {
+  size_t total = dumpSize(snap);
+  if (offset >= total) {
+    return 0;
+  }
+
+  size_t written = 0;
+
+  // Заголовок (формируется на лету, если фрагмент его захватывает)
+  if (offset < sizeof(FlightLogHeader)) {
+    FlightLogHeader header;
+    memcpy(header.magic, "QSFR", 4);
+    header.version = FLIGHT_RECORDER_FORMAT_VERSION;
+    header.recordSize = sizeof(FlightRecord);
+    header.count = snap.count;
+    header.total = snap.first + snap.count;
+    header.timeUs = snap.timeUs;
+
+    size_t n = sizeof(FlightLogHeader) - offset;
+    if (n > maxLen) n = maxLen;
+    memcpy(buffer, (const uint8_t*)&header + offset, n);
+    written += n;
+    offset += n;
+  }
+
+  // Записи копируются из кольца в буфер отправки по одной под блокировкой,
+  // чтобы не отдать запись, которую другое ядро заполняет в этот момент.
+  // Записи, перезаписанные во время выгрузки, декодер распознает по
+  // нарушению порядка времени.
+  while (written < maxLen && offset < total) {
+    size_t recordOffset = offset - sizeof(FlightLogHeader);
+    uint32_t seq = snap.first + recordOffset / sizeof(FlightRecord);
+    size_t within = recordOffset % sizeof(FlightRecord);
+
+    FlightRecord record;
+    portENTER_CRITICAL(&_mux);
+    record = _records[seq & (FLIGHT_RECORDER_CAPACITY - 1)];
+    portEXIT_CRITICAL(&_mux);
+
+    size_t n = sizeof(FlightRecord) - within;
+    if (n > maxLen - written) n = maxLen - written;
+
+    memcpy(buffer + written, (const uint8_t*)&record + within, n);
+    written += n;
+    offset += n;
+  }
+
+  return written;
+}
+
+// Всего записей с момента запуска
+uint32_t FlightRecorder::getTotalRecords() const {
+  return _head;
+}
+
+// Емкость кольца
+uint32_t FlightRecorder::getCapacity() const {
+  return FLIGHT_RECORDER_CAPACITY;
+}
+
+// Замер стоимости одной записи в тактах процессора на отдельном экземпляре
+bool FlightRecorder::measureOverhead(uint16_t iterations, uint32_t& minCycles,
+                                     uint32_t& maxCycles, uint32_t& avgCycles) {
+  minCycles = 0;
+  maxCycles = 0;
+  avgCycles = 0;
+
+  // Метки не должны вытеснять историю из рабочего журнала
+  FlightRecorder* scratch = new (std::nothrow) FlightRecorder();
+  if (!scratch) {
+    return false;
+  }
+
+  minCycles = UINT32_MAX;
+  uint64_t sum = 0;
+
+  for (uint16_t i = 0; i < iterations; i++) {
+    uint32_t start = ESP.getCycleCount();
+    scratch->record(FR_EVENT_MARKER, 0, (int16_t)i, 0);
+    uint32_t cycles = ESP.getCycleCount() - start;
+
+    if (cycles < minCycles) minCycles = cycles;
+    if (cycles > maxCycles) maxCycles = cycles;
+    sum += cycles;
+  }
+
+  if (iterations > 0) {
+    avgCycles = (uint32_t)(sum / iterations);
+  } else {
+    minCycles = 0;
+  }
+
+  delete scratch;
+  return true;
+}
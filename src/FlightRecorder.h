@@ -0,0 +1,133 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <Arduino.h>
+
+// Размер кольцевого буфера в записях (должен быть степенью двойки)
+#define FLIGHT_RECORDER_CAPACITY 1024
+
+// Версия бинарного формата выгрузки (см. tools/flightlog_decode.py)
+#define FLIGHT_RECORDER_FORMAT_VERSION 1
+
+// Типы событий
+enum FlightEventType : uint8_t {
+  FR_EVENT_POSE = 1,        // Заданная позиция: arg=канал, value=угол, aux=импульс
+  FR_EVENT_PWM_COMMIT = 2,  // Запись в PCA9685 завершена: arg=канал, value=импульс, aux=длительность I2C (мкс)
+  FR_EVENT_COMMAND = 3,     // Принята команда: arg=источник, value=код команды
+  FR_EVENT_FAULT = 4,       // Ошибка: arg=источник, value=код ошибки, aux=доп. данные
+  FR_EVENT_MODE = 5,        // Смена режима: value=1 калибровка, 0 рабочий
+  FR_EVENT_MARKER = 6       // Служебная отметка (замер накладных расходов)
+};
+
+// Источники команд
+enum CommandSource : uint8_t {
+  SRC_NONE = 0,
+  SRC_SERIAL = 1,
+  SRC_WEBSOCKET = 2,
+  SRC_HTTP = 3,
+  SRC_UDP = 4
+};
+
+// Коды команд
+enum CommandCode : int16_t {
+  CMD_GET_CONFIG = 1,
+  CMD_SET_POSITION = 2,
+  CMD_CALIBRATE = 3,
+  CMD_SET_ALL_POSITIONS = 4,
+  CMD_CENTER_ALL = 5,
+  CMD_MIN_ALL = 6,
+  CMD_MAX_ALL = 7,
+  CMD_SET_FREQUENCY = 8,
+  CMD_SAVE_SETTINGS = 9,
+  CMD_CALIBRATION_MODE = 10,
+  CMD_WORKING_MODE = 11,
+  CMD_SET_CURRENT_BUDGET = 12,
+  CMD_PUT_CONFIG = 13,
+  CMD_TRAJ_START = 14,
+  CMD_TRAJ_STOP = 15,
+  CMD_UDP_POSE = 16,
+  CMD_SET_FEET = 17
+};
+
+// Коды ошибок
+enum FaultCode : int16_t {
+  FAULT_JSON_PARSE = 1,
+  FAULT_WIFI_CONNECT = 2,
+  FAULT_SPIFFS_MOUNT = 3,
+  FAULT_UNKNOWN_COMMAND = 4,
+  FAULT_LATENCY_SLO = 5
+};
+
+// Одна запись журнала (12 байт, без форматирования на горячем пути)
+struct FlightRecord {
+  uint32_t timeUs;  // micros() в момент записи
+  uint8_t type;     // FlightEventType
+  uint8_t arg;      // Канал или источник
+  int16_t value;    // Угол, импульс или код
+  uint32_t aux;     // Дополнительные данные
+};
+
+// Заголовок выгрузки, предшествующий записям
+struct FlightLogHeader {
+  char magic[4];        // "QSFR"
+  uint16_t version;     // FLIGHT_RECORDER_FORMAT_VERSION
+  uint16_t recordSize;  // sizeof(FlightRecord)
+  uint32_t count;       // Количество записей в выгрузке
+  uint32_t total;       // Всего записей с момента запуска
+  uint32_t timeUs;      // micros() в момент снимка
+};
+
+// Снимок положения кольца на момент запроса выгрузки
+struct FlightLogSnapshot {
+  uint32_t first;   // Порядковый номер самой старой записи
+  uint32_t count;   // Количество записей
+  uint32_t timeUs;  // micros() в момент снимка
+};
+
+class FlightRecorder {
+public:
+  FlightRecorder();
+
+  // Запись события: постоянное время, без выделения памяти и форматирования
+  inline void record(uint8_t type, uint8_t arg, int16_t value, uint32_t aux = 0) {
+    uint32_t now = micros();
+    portENTER_CRITICAL(&_mux);
+    FlightRecord& r = _records[_head & (FLIGHT_RECORDER_CAPACITY - 1)];
+    _head++;
+    r.timeUs = now;
+    r.type = type;
+    r.arg = arg;
+    r.value = value;
+    r.aux = aux;
+    portEXIT_CRITICAL(&_mux);
+  }
+
+  // Снимок текущего состояния кольца для последующей выгрузки
+  FlightLogSnapshot snapshot() const;
+
+  // Размер выгрузки в байтах (заголовок + записи)
+  size_t dumpSize(const FlightLogSnapshot& snap) const;
+
+  // Заполнение очередного фрагмента выгрузки начиная с байта offset
+  // напрямую из кольца, без промежуточной копии. Возвращает 0 в конце.
+  size_t read(const FlightLogSnapshot& snap, size_t offset, uint8_t* buffer, size_t maxLen) const;
+
+  // Статистика
+  uint32_t getTotalRecords() const;
+  uint32_t getCapacity() const;
+
+  // Замер стоимости record() в тактах процессора. Метки пишутся во
+  // временный экземпляр в куче; false - не хватило памяти
+  static bool measureOverhead(uint16_t iterations, uint32_t& minCycles, uint32_t& maxCycles,
+                              uint32_t& avgCycles);
+
+private:
+  FlightRecord _records[FLIGHT_RECORDER_CAPACITY];
+  volatile uint32_t _head;  // Порядковый номер следующей записи
+  mutable portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+// Глобальный журнал, доступный всем модулям
+extern FlightRecorder flightRecorder;
+
+#endif // FLIGHT_RECORDER_H
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include "JsonBuffer.h"
+
+// Сериализация документа в разделяемый буфер
+JsonSharedBuffer serializeJsonBuffer(const JsonDocument& doc) {
+  // serializeJson(doc, char*, size) резервирует последний байт под ноль,
+  // поэтому пишем в буфер на байт больше и затем отрезаем ноль
+  size_t length = measureJson(doc);
+  auto buffer = std::make_shared<std::vector<uint8_t>>(length + 1);
+  size_t written = serializeJson(doc, (char*)buffer->data(), buffer->size());
+  buffer->resize(written);
+  return buffer;
+}
@@ -0,0 +1,15 @@
+#ifndef JSON_BUFFER_H
+#define JSON_BUFFER_H
+
+#include <ArduinoJson.h>
+#include <memory>
+#include <vector>
+
+// Буфер с сериализованным JSON, который разделяют все получатели
+// (совместим с AsyncWebSocketSharedBuffer)
+typedef std::shared_ptr<std::vector<uint8_t>> JsonSharedBuffer;
+
+// Сериализация документа в буфер точно по длине JSON, без завершающего нуля
+JsonSharedBuffer serializeJsonBuffer(const JsonDocument& doc);
+
+#endif // JSON_BUFFER_H
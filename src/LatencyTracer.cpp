@@ -0,0 +1,119 @@
+#include "LatencyTracer.h"
+#include "FlightRecorder.h"
+#include <algorithm>
+
+// Конструктор
+LatencyTracer::LatencyTracer()
+  : _sampleHead(0),
+    _sampleCount(0),
+    _sloViolations(0),
+    _traceTimeouts(0) {
+  memset(_pending, 0, sizeof(_pending));
+  memset(_samples, 0, sizeof(_samples));
+}
+
+// Начало отслеживания команды движения
+void LatencyTracer::begin(uint32_t seq, uint8_t servoIndex, uint32_t rxUs, uint32_t dispatchUs) {
+  portENTER_CRITICAL(&_mux);
+
+  // Занимаем свободный слот, при переполнении вытесняем самый старый
+  uint8_t slot = 0;
+  for (uint8_t i = 0; i < LATENCY_MAX_PENDING; i++) {
+    if (!_pending[i].used) {
+      slot = i;
+      break;
+    }
+    if ((int32_t)(_pending[i].rxUs - _pending[slot].rxUs) < 0) {
+      slot = i;
+    }
+  }
+
+  _pending[slot].used = true;
+  _pending[slot].seq = seq;
+  _pending[slot].servoIndex = servoIndex;
+  _pending[slot].rxUs = rxUs;
+  _pending[slot].dispatchUs = dispatchUs;
+
+  portEXIT_CRITICAL(&_mux);
+}
+
+// Завершение отслеживания по времени взятия цели тактом и записи в PCA9685
+void LatencyTracer::update(const ServoController* servoController,
+                           const MotionScheduler* motionScheduler) {
+  uint32_t now = micros();
+
+  portENTER_CRITICAL(&_mux);
+  for (uint8_t i = 0; i < LATENCY_MAX_PENDING; i++) {
+    PendingTrace& trace = _pending[i];
+    if (!trace.used) continue;
+
+    // Запись учитывается, только если она сделана после взятия цели тактом
+    // (а не прямой записью в обход планировщика)
+    uint32_t pickupUs = motionScheduler->getLastPickupMicros(trace.servoIndex);
+    uint32_t commitUs = servoController->getLastCommitMicros(trace.servoIndex);
+    if ((int32_t)(pickupUs - trace.dispatchUs) >= 0 && (int32_t)(commitUs - pickupUs) >= 0) {
+      addSample(trace.dispatchUs - trace.rxUs, pickupUs - trace.dispatchUs, commitUs - pickupUs);
+      trace.used = false;
+    } else if (now - trace.rxUs > LATENCY_TRACE_TIMEOUT_US) {
+      // Отслеживаются только команды с записью в PCA9685,
+      // поэтому тайм-аут означает потерянную или зависшую команду
+      trace.used = false;
+      _traceTimeouts++;
+    }
+  }
+  portEXIT_CRITICAL(&_mux);
+}
+
+// Добавление замера (вызывается под блокировкой)
+void LatencyTracer::addSample(uint32_t parseUs, uint32_t queueUs, uint32_t i2cUs) {
+  uint32_t totalUs = parseUs + queueUs + i2cUs;
+
+  _samples[LATENCY_STAGE_PARSE][_sampleHead] = parseUs;
+  _samples[LATENCY_STAGE_QUEUE][_sampleHead] = queueUs;
+  _samples[LATENCY_STAGE_I2C][_sampleHead] = i2cUs;
+  _samples[LATENCY_STAGE_TOTAL][_sampleHead] = totalUs;
+  _sampleHead = (_sampleHead + 1) % LATENCY_SAMPLE_COUNT;
+  if (_sampleCount < LATENCY_SAMPLE_COUNT) {
+    _sampleCount++;
+  }
+
+  if (totalUs > LATENCY_SLO_US) {
+    _sloViolations++;
+    flightRecorder.record(FR_EVENT_FAULT, SRC_WEBSOCKET, FAULT_LATENCY_SLO, totalUs);
+  }
+}
+
+// Перцентили этапа
+void LatencyTracer::getStats(LatencyStage stage, uint32_t& p50, uint32_t& p99) const {
+  uint32_t sorted[LATENCY_SAMPLE_COUNT];
+
+  portENTER_CRITICAL(&_mux);
+  uint16_t count = _sampleCount;
+  memcpy(sorted, _samples[stage], count * sizeof(uint32_t));
+  portEXIT_CRITICAL(&_mux);
+
+  if (count == 0) {
+    p50 = 0;
+    p99 = 0;
+    return;
+  }
+
+  std::sort(sorted, sorted + count);
+  p50 = sorted[(count - 1) * 50 / 100];
+  p99 = sorted[(count - 1) * 99 / 100];
+}
+
+// Количество замеров в окне
+uint16_t LatencyTracer::getSampleCount() const {
+  return _sampleCount;
+}
+
+// Количество нарушений целевой задержки
+uint32_t LatencyTracer::getSloViolations() const {
+  return _sloViolations;
+}
+
+// Количество команд, не дождавшихся записи в PCA9685
+uint32_t LatencyTracer::getTraceTimeouts() const {
+  return _traceTimeouts;
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef LATENCY_TRACER_H
+#define LATENCY_TRACER_H
+
+#include <Arduino.h>
+#include "ServoController.h"
+#include "MotionScheduler.h"
+
+// Количество хранимых замеров для расчета перцентилей
+#define LATENCY_SAMPLE_COUNT 64
+// Максимум одновременно отслеживаемых команд
+#define LATENCY_MAX_PENDING 8
+// Команда без записи в PCA9685 за это время перестает отслеживаться, мкс
+#define LATENCY_TRACE_TIMEOUT_US 500000
+// Целевая задержка от приема команды до записи в PCA9685, мкс
+#define LATENCY_SLO_US 20000
+
+// Этапы прохождения команды
+enum LatencyStage : uint8_t {
+  LATENCY_STAGE_PARSE = 0,   // Прием WebSocket -> команда разобрана и передана планировщику
+  LATENCY_STAGE_QUEUE = 1,   // Передана планировщику -> цель взята тактом планировщика
+  LATENCY_STAGE_I2C = 2,     // Взята тактом -> запись в PCA9685 по I2C завершена
+  LATENCY_STAGE_TOTAL = 3,   // Прием WebSocket -> запись в PCA9685 завершена
+  LATENCY_STAGE_COUNT = 4
+};
+
+// Трассировка задержек команд от приема до записи в PCA9685
+class LatencyTracer {
+public:
+  LatencyTracer();
+
+  // Начало отслеживания команды движения (вызывается из обработчика WebSocket)
+  void begin(uint32_t seq, uint8_t servoIndex, uint32_t rxUs, uint32_t dispatchUs);
+
+  // Завершение отслеживания по времени взятия цели тактом и записи
+  // в PCA9685 (вызывается из loop)
+  void update(const ServoController* servoController, const MotionScheduler* motionScheduler);
+
+  // Перцентили этапа в микросекундах
+  void getStats(LatencyStage stage, uint32_t& p50, uint32_t& p99) const;
+  uint16_t getSampleCount() const;
+  uint32_t getSloViolations() const;
+  uint32_t getTraceTimeouts() const;
+
+private:
+  struct PendingTrace {
+    bool used;
+    uint32_t seq;
+    uint8_t servoIndex;
+    uint32_t rxUs;
+    uint32_t dispatchUs;
+  };
+
+  PendingTrace _pending[LATENCY_MAX_PENDING];
+  uint32_t _samples[LATENCY_STAGE_COUNT][LATENCY_SAMPLE_COUNT];
+  uint16_t _sampleHead;
+  uint16_t _sampleCount;
+  uint32_t _sloViolations;
+  uint32_t _traceTimeouts;   // Команды, не дошедшие до PCA9685 за LATENCY_TRACE_TIMEOUT_US
+  mutable portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+  void addSample(uint32_t parseUs, uint32_t queueUs, uint32_t i2cUs);
+};
+
+#endif // LATENCY_TRACER_H
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "Logger.h"
+
+// Период опроса кольца задачей вывода, мс
+#define LOGGER_POLL_MS 10
+
+// Глобальный экземпляр журнала
+Logger logger;
+
+// Конструктор
+Logger::Logger() : _enqueuePos(0), _dequeuePos(0), _written(0), _dropped(0), _task(nullptr) {
+  for (uint32_t i = 0; i < LOGGER_CAPACITY; i++) {
+    _slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+// Запуск задачи вывода
+void Logger::begin() {
+  if (_task) {
+    return;
+  }
+  // Приоритет ниже задачи loop: вывод не отнимает время у управления
+  xTaskCreate(taskEntry, "logger", 3072, this, tskIDLE_PRIORITY, &_task);
+}
+
+// Запись в кольцо (ограниченная MPMC-очередь Вьюкова, здесь один потребитель)
+bool Logger::push(uint8_t level, const char* format, const uintptr_t* args, uint8_t argc) {
+  uint32_t now = micros();
+  uint32_t pos = _enqueuePos.load(std::memory_order_relaxed);
+  Slot* slot;
+
+  for (;;) {
+    slot = &_slots[pos & (LOGGER_CAPACITY - 1)];
+    uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+    int32_t diff = (int32_t)(sequence - pos);
+
+    if (diff == 0) {
+      // Слот свободен - занимаем позицию
+      if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // Кольцо заполнено - не ждем
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      // Позицию занял другой производитель
+      pos = _enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  LogRecord& record = slot->record;
+  record.timeUs = now;
+  record.format = format;
+  record.level = level;
+  record.argc = argc;
+  memcpy(record.args, args, argc * sizeof(uintptr_t));
+
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+// Вывод накопленных записей
+void Logger::flush() {
+  for (;;) {
+    Slot& slot = _slots[_dequeuePos & (LOGGER_CAPACITY - 1)];
+    uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if ((int32_t)(sequence - (_dequeuePos + 1)) < 0) {
+      return;
+    }
+
+    LogRecord record = slot.record;
+    slot.sequence.store(_dequeuePos + LOGGER_CAPACITY, std::memory_order_release);
+    _dequeuePos++;
+
+    write(record);
+    _written.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+// Форматирование и вывод одной записи
+void Logger::write(const LogRecord& record) {
+  static const char levels[] = { '-', 'E', 'W', 'I', 'D' };
+  char line[LOGGER_LINE_LENGTH];
+
+  // Лишние аргументы игнорируются: на ESP32 целые и указатели занимают 32 бита
+  uintptr_t args[LOGGER_MAX_ARGS] = { 0 };
+  memcpy(args, record.args, record.argc * sizeof(uintptr_t));
+  snprintf(line, sizeof(line), record.format,
+           args[0], args[1], args[2], args[3], args[4], args[5]);
+
+  uint32_t ms = record.timeUs / 1000;
+  Serial.printf("[%lu.%03lu %c] %s\n", (unsigned long)(ms / 1000), (unsigned long)(ms % 1000),
+                levels[record.level <= LOG_LEVEL_DEBUG ? record.level : 0], line);
+}
+
+// Задача вывода
+void Logger::taskEntry(void* param) {
+  Logger* self = static_cast<Logger*>(param);
+  for (;;) {
+    self->flush();
+    vTaskDelay(pdMS_TO_TICKS(LOGGER_POLL_MS));
+  }
+}
+
+// Статистика
+uint32_t Logger::getWritten() const {
+  return _written.load(std::memory_order_relaxed);
+}
+
+uint32_t Logger::getDropped() const {
+  return _dropped.load(std::memory_order_relaxed);
+}
+
+// Замер стоимости вызова в тактах процессора
+void Logger::measureOverhead(uint16_t iterations, bool direct, uint32_t& minCycles,
+                             uint32_t& maxCycles, uint32_t& avgCycles) {
+  minCycles = UINT32_MAX;
+  maxCycles = 0;
+  uint64_t sum = 0;
+
+  for (uint16_t i = 0; i < iterations; i++) {
+    uint32_t start = ESP.getCycleCount();
+    if (direct) {
+      Serial.printf("logbench %u client #%u from %u.%u.%u.%u\n", i, 1u, 192u, 168u, 4u, 2u);
+    } else {
+      log(LOG_LEVEL_INFO, "logbench %u client #%u from %u.%u.%u.%u", i, 1u, 192u, 168u, 4u, 2u);
+    }
+    uint32_t cycles = ESP.getCycleCount() - start;
+
+    if (cycles < minCycles) minCycles = cycles;
+    if (cycles > maxCycles) maxCycles = cycles;
+    sum += cycles;
+  }
+
+  avgCycles = iterations > 0 ? (uint32_t)(sum / iterations) : 0;
+}
\ No newline at end of file
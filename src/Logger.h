@@ -0,0 +1,120 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <type_traits>
+
+// Уровни журнала
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+// Уровень сборки: вызовы выше него не попадают в прошивку (-DLOG_LEVEL=...)
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// Размер кольца в записях (должен быть степенью двойки)
+#define LOGGER_CAPACITY 64
+#define LOGGER_MAX_ARGS 6
+#define LOGGER_LINE_LENGTH 160
+
+// Запись журнала: строка формата и аргументы, без форматирования
+struct LogRecord {
+  uint32_t timeUs;                  // micros() в момент вызова
+  const char* format;               // Строка формата (статическая)
+  uint8_t level;
+  uint8_t argc;
+  uintptr_t args[LOGGER_MAX_ARGS];
+};
+
+// Отложенный журнал. Вызов только кладет запись в кольцо без блокировок
+// (несколько производителей, один потребитель), форматирование и вывод
+// в Serial выполняет отдельная задача с низким приоритетом. Если кольцо
+// заполнено, запись отбрасывается и учитывается в счетчике.
+// Аргументы - целые (до 32 бит) и указатели на строки, живущие дольше
+// вывода (литералы); String::c_str() временных объектов и float нельзя.
+class Logger {
+public:
+  Logger();
+
+  // Запуск задачи вывода (до запуска записи копятся в кольце)
+  void begin();
+
+  // Запись в кольцо; false - кольцо заполнено
+  template <class... Args>
+  bool log(uint8_t level, const char* format, Args... args) {
+    static_assert(sizeof...(Args) <= LOGGER_MAX_ARGS, "too many log arguments");
+    uintptr_t values[] = { 0, toArg(args)... };
+    return push(level, format, values + 1, sizeof...(Args));
+  }
+
+  // Вывод накопленных записей (вызывается задачей)
+  void flush();
+
+  // Статистика
+  uint32_t getWritten() const;
+  uint32_t getDropped() const;
+
+  // Замер стоимости вызова в тактах: через кольцо или прямым Serial.printf
+  void measureOverhead(uint16_t iterations, bool direct, uint32_t& minCycles,
+                       uint32_t& maxCycles, uint32_t& avgCycles);
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> sequence;
+    LogRecord record;
+  };
+
+  Slot _slots[LOGGER_CAPACITY];
+  std::atomic<uint32_t> _enqueuePos;
+  uint32_t _dequeuePos;  // Только задача вывода
+  std::atomic<uint32_t> _written;
+  std::atomic<uint32_t> _dropped;
+  TaskHandle_t _task;
+
+  bool push(uint8_t level, const char* format, const uintptr_t* args, uint8_t argc);
+  void write(const LogRecord& record);
+  static void taskEntry(void* param);
+
+  template <class T>
+  static uintptr_t toArg(T value) {
+    static_assert(sizeof(T) <= sizeof(uintptr_t) &&
+                  (std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value),
+                  "log arguments must be integers or pointers");
+    return (uintptr_t)value;
+  }
+};
+
+// Глобальный журнал, доступный всем модулям
+extern Logger logger;
+
+// Вызовы с фильтрацией уровня на этапе компиляции
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(format, ...) logger.log(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(format, ...) logger.log(LOG_LEVEL_WARN, format, ##__VA_ARGS__)
+#else
+#define LOG_WARN(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(format, ...) logger.log(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(format, ...) logger.log(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...) do {} while (0)
+#endif
+
+#endif // LOGGER_H
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "MotionPlanner.h"
+#include <math.h>
+
+// Один такт планирования
+float MotionPlanner::tick(MotionPlanState& state, float dt, float budget) {
+  float current = state.count * MOTION_IDLE_CURRENT_MA;
+
+  // Сортируем активные каналы по убыванию оставшегося хода
+  uint8_t order[MOTION_MAX_CHANNELS];
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < state.count; i++) {
+    if (!state.active[i]) continue;
+
+    float remaining = fabsf(state.targets[i] - state.positions[i]);
+    uint8_t j = n++;
+    while (j > 0 &&
+           fabsf(state.targets[order[j - 1]] - state.positions[order[j - 1]]) < remaining) {
+      order[j] = order[j - 1];
+      j--;
+    }
+    order[j] = i;
+  }
+
+  // Распределяем бюджет тока
+  for (uint8_t k = 0; k < n; k++) {
+    uint8_t i = order[k];
+    float delta = state.targets[i] - state.positions[i];
+    float remaining = fabsf(delta);
+    float coeff = state.currentPerSpeed[i];
+
+    float speed = fminf(MOTION_MAX_SPEED, remaining / dt);
+    float available = budget - current;
+    if (available <= 0) break;
+    if (speed * coeff > available) {
+      speed = available / coeff;
+    }
+
+    current += speed * coeff;
+    float step = speed * dt;
+    if (step >= remaining) {
+      state.positions[i] = state.targets[i];
+      state.active[i] = false;
+    } else {
+      state.positions[i] += delta > 0 ? step : -step;
+    }
+  }
+
+  return current;
+}
+
+// Перенос результата такта в общее состояние
+void MotionPlanner::merge(MotionPlanState& shared, const MotionPlanState& snapshot,
+                          const MotionPlanState& planned) {
+  for (uint8_t i = 0; i < shared.count; i++) {
+    if (!snapshot.active[i]) continue;
+
+    shared.positions[i] = planned.positions[i];
+
+    // Завершение учитывается, только если цель не сменили во время такта
+    // (и перемещение не остановили)
+    if (shared.targets[i] == snapshot.targets[i] && !planned.active[i]) {
+      shared.active[i] = false;
+    }
+  }
+}
+
+// Расчет перемещения до завершения
+MotionStats MotionPlanner::simulate(MotionPlanState state, float budget, uint32_t maxMs) {
+  MotionStats stats = { 0, 0 };
+  const float dt = MOTION_TICK_MS / 1000.0f;
+
+  // Ограничение на случай бюджета, не позволяющего двигаться
+  while (isMoving(state) && stats.completionMs < maxMs) {
+    float current = tick(state, dt, budget);
+    if (current > stats.peakCurrent) {
+      stats.peakCurrent = current;
+    }
+    stats.completionMs += MOTION_TICK_MS;
+  }
+
+  return stats;
+}
+
+// Есть ли незавершенные перемещения
+bool MotionPlanner::isMoving(const MotionPlanState& state) {
+  for (uint8_t i = 0; i < state.count; i++) {
+    if (state.active[i]) return true;
+  }
+  return false;
+}
\ No newline at end of file
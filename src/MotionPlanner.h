@@ -0,0 +1,49 @@
+#ifndef MOTION_PLANNER_H
+#define MOTION_PLANNER_H
+
+#include <stdint.h>
+
+// Параметры модели движения
+#define MOTION_MAX_SPEED 300.0f         // Максимальная скорость сервопривода, град/с
+#define MOTION_IDLE_CURRENT_MA 10.0f    // Ток удержания одного сервопривода, мА
+#define MOTION_TICK_MS 10               // Период планировщика, мс
+#define MOTION_MAX_CHANNELS 16
+
+// Результат расчета перемещения (для симуляции и телеметрии)
+struct MotionStats {
+  float peakCurrent;        // Пиковый оценочный ток, мА
+  uint32_t completionMs;    // Время завершения перемещения, мс
+};
+
+// Состояние каналов для расчета
+struct MotionPlanState {
+  uint8_t count;                                // Количество каналов
+  float positions[MOTION_MAX_CHANNELS];         // Текущие позиции, градусы
+  int targets[MOTION_MAX_CHANNELS];             // Целевые позиции
+  bool active[MOTION_MAX_CHANNELS];             // Перемещение не завершено
+  float currentPerSpeed[MOTION_MAX_CHANNELS];   // Коэффициент тока, мА на град/с
+};
+
+// Расчет перемещений с ограничением суммарного тока, без обращения к
+// оборудованию. На каждом такте бюджет распределяется в первую очередь
+// на каналы с наибольшим оставшимся ходом.
+class MotionPlanner {
+public:
+  // Один такт: продвигает позиции к целям за dt секунд,
+  // возвращает оценочный ток
+  static float tick(MotionPlanState& state, float dt, float budget);
+
+  // Перенос результата такта, рассчитанного по снимку snapshot, в общее
+  // состояние shared, которое могло измениться за время расчета: новые
+  // цели, заданные во время такта, не сбрасываются
+  static void merge(MotionPlanState& shared, const MotionPlanState& snapshot,
+                    const MotionPlanState& planned);
+
+  // Расчет перемещения до завершения, но не дольше maxMs
+  static MotionStats simulate(MotionPlanState state, float budget, uint32_t maxMs = 60000);
+
+  // Есть ли незавершенные перемещения
+  static bool isMoving(const MotionPlanState& state);
+};
+
+#endif // MOTION_PLANNER_H
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "MotionScheduler.h"
+
+// Конструктор
+MotionScheduler::MotionScheduler(ServoController* servoController)
+  : _servoController(servoController),
+    _budget(DEFAULT_CURRENT_BUDGET_MA),
+    _limitsEnabled(false),
+    _estimatedCurrent(0),
+    _peakCurrent(0),
+    _lastTick(0) {
+  memset(&_state, 0, sizeof(_state));
+  _state.count = servoController->getServoCount();
+  for (uint8_t i = 0; i < MOTION_MAX_CHANNELS; i++) {
+    _state.positions[i] = 90;
+    _state.targets[i] = 90;
+    _minAngle[i] = 0;
+    _maxAngle[i] = 180;
+    _pickupPending[i] = false;
+    _pickupUs[i] = 0;
+  }
+}
+
+// Инициализация
+void MotionScheduler::begin() {
+  _preferences.begin("motion", true);
+  _budget = _preferences.getUInt("budget", DEFAULT_CURRENT_BUDGET_MA);
+  _preferences.end();
+
+  _estimatedCurrent = _servoController->getServoCount() * MOTION_IDLE_CURRENT_MA;
+  _lastTick = millis();
+}
+
+// Коэффициент тока по классу нагрузки
+float MotionScheduler::currentPerSpeed(uint8_t loadClass) {
+  switch (loadClass) {
+    case LOAD_CLASS_LIGHT: return 2.0f;
+    case LOAD_CLASS_HEAVY: return 5.0f;
+    default: return 3.5f;
+  }
+}
+
+// Коэффициенты тока по классам нагрузки сервоприводов
+void MotionScheduler::fillCurrentPerSpeed(MotionPlanState& state) const {
+  for (uint8_t i = 0; i < state.count; i++) {
+    state.currentPerSpeed[i] = currentPerSpeed(_servoController->getLoadClass(i));
+  }
+}
+
+// Перемещение одного сервопривода
+bool MotionScheduler::moveTo(uint8_t servoIndex, int angle) {
+  if (servoIndex >= _servoController->getServoCount()) {
+    return false;
+  }
+
+  if (_limitsEnabled) {
+    angle = constrain(angle, _minAngle[servoIndex], _maxAngle[servoIndex]);
+  } else {
+    angle = constrain(angle, 0, 180);
+  }
+  int position = _servoController->getCurrentPosition(servoIndex);
+  bool changed;
+
+  portENTER_CRITICAL(&_mux);
+  if (_state.active[servoIndex]) {
+    changed = _state.targets[servoIndex] != angle;
+    _state.targets[servoIndex] = angle;
+  } else {
+    // Начинаем с фактической позиции, если сервопривод двигали в обход планировщика
+    _state.positions[servoIndex] = position;
+    _state.targets[servoIndex] = angle;
+    // Сервопривод уже в цели - перемещать нечего
+    changed = position != angle;
+    _state.active[servoIndex] = changed;
+  }
+  if (changed) {
+    _pickupPending[servoIndex] = true;
+  }
+  portEXIT_CRITICAL(&_mux);
+
+  return changed;
+}
+
+// Перемещение всех сервоприводов
+int MotionScheduler::moveAll(int angle) {
+  int firstChanged = -1;
+  for (uint8_t i = 0; i < _servoController->getServoCount(); i++) {
+    if (moveTo(i, angle) && firstChanged < 0) {
+      firstChanged = i;
+    }
+  }
+  return firstChanged;
+}
+
+// Остановка всех перемещений в текущих позициях
+void MotionScheduler::stop() {
+  portENTER_CRITICAL(&_mux);
+  for (uint8_t i = 0; i < MOTION_MAX_CHANNELS; i++) {
+    _state.active[i] = false;
+    _pickupPending[i] = false;
+  }
+  portEXIT_CRITICAL(&_mux);
+}
+
+// Допустимые углы сервопривода
+void MotionScheduler::setAngleLimits(uint8_t servoIndex, int minAngle, int maxAngle) {
+  if (servoIndex >= MOTION_MAX_CHANNELS || minAngle > maxAngle) {
+    return;
+  }
+  _minAngle[servoIndex] = constrain(minAngle, 0, 180);
+  _maxAngle[servoIndex] = constrain(maxAngle, 0, 180);
+}
+
+// Включение пределов
+void MotionScheduler::setLimitsEnabled(bool enabled) {
+  _limitsEnabled = enabled;
+}
+
+// Обработка такта
+void MotionScheduler::update() {
+  unsigned long now = millis();
+  if (now - _lastTick < MOTION_TICK_MS) {
+    return;
+  }
+  // Ограничиваем шаг, если loop был надолго занят
+  float dt = min((now - _lastTick) / 1000.0f, MOTION_TICK_MS * 5 / 1000.0f);
+  _lastTick = now;
+
+  // Снимок состояния; такт рассчитывается без блокировки
+  MotionPlanState snapshot;
+  uint32_t pickupUs = micros();
+  portENTER_CRITICAL(&_mux);
+  snapshot = _state;
+  for (uint8_t i = 0; i < snapshot.count; i++) {
+    if (_pickupPending[i] && snapshot.active[i]) {
+      _pickupPending[i] = false;
+      _pickupUs[i] = pickupUs;
+    }
+  }
+  portEXIT_CRITICAL(&_mux);
+
+  if (!MotionPlanner::isMoving(snapshot)) {
+    _estimatedCurrent = _servoController->getServoCount() * MOTION_IDLE_CURRENT_MA;
+    return;
+  }
+
+  fillCurrentPerSpeed(snapshot);
+  MotionPlanState planned = snapshot;
+  _estimatedCurrent = MotionPlanner::tick(planned, dt, _budget);
+  if (_estimatedCurrent > _peakCurrent) {
+    _peakCurrent = _estimatedCurrent;
+  }
+
+  portENTER_CRITICAL(&_mux);
+  MotionPlanner::merge(_state, snapshot, planned);
+  portEXIT_CRITICAL(&_mux);
+
+  // Отправляем в PCA9685 только изменившиеся позиции. Промежуточные шаги
+  // не пишутся в бортовой журнал, иначе групповое перемещение вытесняет
+  // из него всю историю; запись делается по завершении перемещения
+  for (uint8_t i = 0; i < snapshot.count; i++) {
+    if (!snapshot.active[i]) continue;
+
+    int angle = (int)lroundf(planned.positions[i]);
+    bool arrived = !planned.active[i];
+    if (angle != _servoController->getCurrentPosition(i) || arrived) {
+      _servoController->setPosition(i, angle, arrived);
+    }
+  }
+}
+
+// Установка бюджета тока
+void MotionScheduler::setCurrentBudget(uint16_t budgetMa) {
+  // Бюджет не может быть меньше тока удержания всех сервоприводов
+  uint16_t minimum = _servoController->getServoCount() * MOTION_IDLE_CURRENT_MA + 100;
+  if (budgetMa < minimum) {
+    budgetMa = minimum;
+  }
+
+  _budget = budgetMa;
+
+  _preferences.begin("motion", false);
+  _preferences.putUInt("budget", _budget);
+  _preferences.end();
+}
+
+// Получение бюджета тока
+uint16_t MotionScheduler::getCurrentBudget() const {
+  return _budget;
+}
+
+// Текущий оценочный ток
+float MotionScheduler::getEstimatedCurrent() const {
+  return _estimatedCurrent;
+}
+
+// Пиковый оценочный ток
+float MotionScheduler::getPeakCurrent() const {
+  return _peakCurrent;
+}
+
+// Сброс пикового значения
+void MotionScheduler::resetPeakCurrent() {
+  _peakCurrent = _estimatedCurrent;
+}
+
+// Есть ли незавершенные перемещения
+bool MotionScheduler::isMoving() const {
+  return MotionPlanner::isMoving(_state);
+}
+
+// Время взятия последней новой цели в работу (micros)
+uint32_t MotionScheduler::getLastPickupMicros(uint8_t servoIndex) const {
+  if (servoIndex < MOTION_MAX_CHANNELS) {
+    return _pickupUs[servoIndex];
+  }
+  return 0;
+}
+
+// Симуляция перемещения всех сервоприводов (без движения)
+MotionStats MotionScheduler::simulateMoveAll(int angle, bool unlimited) const {
+  MotionPlanState state;
+  memset(&state, 0, sizeof(state));
+  state.count = _servoController->getServoCount();
+
+  for (uint8_t i = 0; i < state.count; i++) {
+    state.positions[i] = _servoController->getCurrentPosition(i);
+    state.targets[i] = constrain(angle, 0, 180);
+    state.active[i] = true;
+  }
+  fillCurrentPerSpeed(state);
+
+  return MotionPlanner::simulate(state, unlimited ? 1e9f : _budget);
+}
\ No newline at end of file
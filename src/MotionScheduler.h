@@ -0,0 +1,82 @@
+#ifndef MOTION_SCHEDULER_H
+#define MOTION_SCHEDULER_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "ServoController.h"
+#include "MotionPlanner.h"
+
+// Настройки по умолчанию
+#define DEFAULT_CURRENT_BUDGET_MA 5000  // Допустимый суммарный ток, мА
+
+// Планировщик перемещений с ограничением суммарного тока.
+// Ток сервопривода оценивается как ток удержания плюс слагаемое,
+// пропорциональное скорости, с коэффициентом по классу нагрузки.
+// На каждом такте бюджет распределяется в первую очередь на сервоприводы
+// с наибольшим оставшимся ходом, чтобы все перемещение завершилось быстрее.
+// Команды приходят из задачи AsyncTCP, такты выполняются в loop на другом
+// ядре, поэтому общее состояние защищено блокировкой, а расчет такта
+// идет по снимку без блокировки.
+class MotionScheduler {
+public:
+  MotionScheduler(ServoController* servoController);
+
+  // Инициализация (загрузка бюджета из памяти)
+  void begin();
+
+  // Постановка перемещений в очередь.
+  // moveTo возвращает true, если цель канала изменилась (будет запись в PCA9685),
+  // moveAll - индекс первого такого канала или -1
+  bool moveTo(uint8_t servoIndex, int angle);
+  int moveAll(int angle);
+  void stop();
+
+  // Допустимые углы сервопривода (по умолчанию 0-180). Пределы суставов
+  // задает RobotModel::applyLimits; в режиме калибровки их отключают,
+  // чтобы можно было выставить крайние импульсы
+  void setAngleLimits(uint8_t servoIndex, int minAngle, int maxAngle);
+  void setLimitsEnabled(bool enabled);
+
+  // Обработка такта (вызывается из loop)
+  void update();
+
+  // Бюджет тока
+  void setCurrentBudget(uint16_t budgetMa);
+  uint16_t getCurrentBudget() const;
+
+  // Телеметрия
+  float getEstimatedCurrent() const;
+  float getPeakCurrent() const;
+  void resetPeakCurrent();
+  bool isMoving() const;
+
+  // Время (micros), когда такт впервые взял в работу последнюю новую цель
+  // канала: от него до записи в PCA9685 - время записи, до него - ожидание такта
+  uint32_t getLastPickupMicros(uint8_t servoIndex) const;
+
+  // Симуляция перемещения всех сервоприводов в угол angle без движения
+  MotionStats simulateMoveAll(int angle, bool unlimited = false) const;
+
+private:
+  ServoController* _servoController;
+  Preferences _preferences;
+  uint16_t _budget;
+  MotionPlanState _state;
+  int16_t _minAngle[MOTION_MAX_CHANNELS];
+  int16_t _maxAngle[MOTION_MAX_CHANNELS];
+  bool _pickupPending[MOTION_MAX_CHANNELS];       // Новая цель еще не взята тактом
+  volatile uint32_t _pickupUs[MOTION_MAX_CHANNELS];
+  volatile bool _limitsEnabled;
+  float _estimatedCurrent;
+  float _peakCurrent;
+  unsigned long _lastTick;
+  mutable portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+  // Коэффициенты тока по классам нагрузки сервоприводов
+  void fillCurrentPerSpeed(MotionPlanState& state) const;
+
+  // Коэффициент тока по классу нагрузки, мА на град/с
+  static float currentPerSpeed(uint8_t loadClass);
+};
+
+#endif // MOTION_SCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "RadioPowerManager.h"
+#include "FlightRecorder.h"
+#include "Logger.h"
+
+// Конструктор
+RadioPowerManager::RadioPowerManager(RadioLink* link)
+  : _link(link),
+    _apMode(true),
+    _state(RADIO_OFF),
+    _connecting(false),
+    _connectStart(0),
+    _lastTransitionUs(0),
+    _stateSince(0) {
+  for (uint8_t i = 0; i < RADIO_STATE_COUNT; i++) {
+    _residencyMs[i] = 0;
+  }
+}
+
+// Параметры сети
+void RadioPowerManager::configure(const String& ssid, const String& password, bool apMode) {
+  bool changed = ssid != _ssid || password != _password || apMode != _apMode;
+  _ssid = ssid;
+  _password = password;
+  _apMode = apMode;
+
+  // Перезапускаем связь с новыми параметрами, сохраняя режим питания
+  if (changed && _state != RADIO_OFF) {
+    stopLink();
+    startLink();
+    applyPowerSave(_state);
+  }
+}
+
+// Переход в состояние
+void RadioPowerManager::setState(RadioState state) {
+  if (state == _state) {
+    return;
+  }
+
+  uint32_t start = micros();
+
+  if (_state == RADIO_OFF) {
+    startLink();
+  }
+
+  if (state == RADIO_OFF) {
+    stopLink();
+  } else {
+    applyPowerSave(state);
+  }
+
+  // Учет времени пребывания в предыдущем состоянии
+  unsigned long now = millis();
+  _residencyMs[_state] += now - _stateSince;
+  _stateSince = now;
+  _state = state;
+
+  _lastTransitionUs = micros() - start;
+}
+
+// Текущее состояние
+RadioState RadioPowerManager::getState() const {
+  return _state;
+}
+
+// Связь установлена
+bool RadioPowerManager::isLinkUp() const {
+  if (_state == RADIO_OFF) {
+    return false;
+  }
+  return _apMode || _link->isConnected();
+}
+
+// Отслеживание подключения станции
+void RadioPowerManager::update() {
+  if (!_connecting) {
+    return;
+  }
+
+  if (_link->isConnected()) {
+    _connecting = false;
+    uint32_t ip = _link->localAddress(false);
+    LOG_INFO("Connected to WiFi. IP Address: %u.%u.%u.%u",
+             ip & 0xFF, (ip >> 8) & 0xFF, (ip >> 16) & 0xFF, ip >> 24);
+  } else if (millis() - _connectStart > RADIO_CONNECT_TIMEOUT_MS) {
+    // Повторные попытки выполняет сам стек WiFi, здесь только фиксируем ошибку
+    _connecting = false;
+    flightRecorder.record(FR_EVENT_FAULT, SRC_NONE, FAULT_WIFI_CONNECT, _link->status());
+    LOG_ERROR("Failed to connect to WiFi");
+  }
+}
+
+// Запуск связи
+void RadioPowerManager::startLink() {
+  if (_apMode) {
+    // Режим точки доступа
+    _link->startAccessPoint(_ssid, _password);
+    uint32_t ip = _link->localAddress(true);
+    LOG_INFO("Access Point started. IP Address: %u.%u.%u.%u",
+             ip & 0xFF, (ip >> 8) & 0xFF, (ip >> 16) & 0xFF, ip >> 24);
+  } else {
+    // Режим подключения к существующей сети, без ожидания
+    _link->startStation(_ssid, _password);
+    _connecting = true;
+    _connectStart = millis();
+    LOG_INFO("Station started, connecting...");
+  }
+}
+
+// Остановка связи
+void RadioPowerManager::stopLink() {
+  _connecting = false;
+  _link->stop();
+}
+
+// Настройка энергосбережения
+void RadioPowerManager::applyPowerSave(RadioState state) {
+  _link->setPowerSave(_apMode, state == RADIO_MODEM_SLEEP);
+}
+
+// Длительность последнего перехода
+uint32_t RadioPowerManager::getLastTransitionUs() const {
+  return _lastTransitionUs;
+}
+
+// Время пребывания в состоянии, включая текущее
+uint32_t RadioPowerManager::getResidencyMs(RadioState state) const {
+  if (state >= RADIO_STATE_COUNT) {
+    return 0;
+  }
+  uint32_t residency = _residencyMs[state];
+  if (state == _state) {
+    residency += millis() - _stateSince;
+  }
+  return residency;
+}
+
+// Имя состояния
+const char* RadioPowerManager::stateName(RadioState state) {
+  switch (state) {
+    case RADIO_OFF: return "off";
+    case RADIO_MODEM_SLEEP: return "sleep";
+    case RADIO_FULL_POWER: return "full";
+    default: return "unknown";
+  }
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef RADIO_POWER_MANAGER_H
+#define RADIO_POWER_MANAGER_H
+
+#include <Arduino.h>
+
+// Таймаут подключения к точке доступа в режиме станции, мс
+#define RADIO_CONNECT_TIMEOUT_MS 20000
+
+// Состояния радиомодуля
+enum RadioState : uint8_t {
+  RADIO_OFF = 0,          // WiFi выключен полностью
+  RADIO_MODEM_SLEEP = 1,  // Связь сохранена, радио в энергосбережении
+  RADIO_FULL_POWER = 2,   // Полная мощность, без энергосбережения
+  RADIO_STATE_COUNT = 3
+};
+
+// Низкоуровневое управление радиомодулем. Вынесено из RadioPowerManager,
+// чтобы логику состояний можно было проверять без WiFi (реализация для
+// ESP32 - WiFiRadioLink)
+class RadioLink {
+public:
+  virtual ~RadioLink() {}
+
+  // Запуск точки доступа или подключения станции (без ожидания)
+  virtual void startAccessPoint(const String& ssid, const String& password) = 0;
+  virtual void startStation(const String& ssid, const String& password) = 0;
+  virtual void stop() = 0;
+
+  // Энергосбережение: modem sleep для станции, сниженная мощность для точки доступа
+  virtual void setPowerSave(bool apMode, bool enabled) = 0;
+
+  // Станция подключена
+  virtual bool isConnected() const = 0;
+  // Код состояния для бортового журнала
+  virtual int status() const = 0;
+  // IPv4-адрес (первый октет в младшем байте)
+  virtual uint32_t localAddress(bool apMode) const = 0;
+};
+
+// Управление питанием WiFi. Переход между энергосбережением и полной
+// мощностью не разрывает связь, поэтому выход из рабочего режима быстрый.
+// Подключение в режиме станции не блокирует вызывающий код: результат
+// отслеживается в update().
+class RadioPowerManager {
+public:
+  RadioPowerManager(RadioLink* link);
+
+  // Параметры сети; при смене параметров активная связь перезапускается
+  void configure(const String& ssid, const String& password, bool apMode);
+
+  // Переход в состояние
+  void setState(RadioState state);
+  RadioState getState() const;
+
+  // Связь установлена (точка доступа запущена или станция подключена)
+  bool isLinkUp() const;
+
+  // Отслеживание подключения станции (вызывается из loop)
+  void update();
+
+  // Телеметрия
+  uint32_t getLastTransitionUs() const;
+  uint32_t getResidencyMs(RadioState state) const;
+  static const char* stateName(RadioState state);
+
+private:
+  RadioLink* _link;
+  String _ssid, _password;
+  bool _apMode;
+  RadioState _state;
+  bool _connecting;
+  unsigned long _connectStart;
+  uint32_t _lastTransitionUs;
+  uint32_t _residencyMs[RADIO_STATE_COUNT];
+  unsigned long _stateSince;
+
+  void startLink();
+  void stopLink();
+  void applyPowerSave(RadioState state);
+};
+
+#endif // RADIO_POWER_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef ROBOT_DESCRIPTION_H
+#define ROBOT_DESCRIPTION_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Описание робота на этапе компиляции: ноги, суставы, каналы PCA9685,
+// направления и пределы. Вариант робота выбирается флагом сборки
+// (см. platformio.ini), поэтому во время работы таблиц и поиска нет -
+// все значения подставляются компилятором как константы.
+
+namespace robot {
+
+// Сустав: канал PCA9685 и преобразование угла сустава в угол сервопривода
+struct Joint {
+  uint8_t channel;    // Канал PCA9685
+  int8_t direction;   // 1 или -1 (инверсия направления)
+  int16_t neutral;    // Угол сервопривода при нулевом угле сустава
+  int16_t minAngle;   // Предел угла сустава, градусы
+  int16_t maxAngle;
+};
+
+// Нога из трех суставов: отведение (coxa), бедро (femur), голень (tibia)
+struct Leg {
+  Joint coxa;
+  Joint femur;
+  Joint tibia;
+  float coxaLength;   // Длины звеньев, мм
+  float femurLength;
+  float tibiaLength;
+};
+
+// Базовый вариант: 12 сервоприводов на каналах 0-11, правые ноги зеркальны
+struct QuadSpot {
+  static constexpr const char* name = "QuadSpot";
+  static constexpr uint8_t legCount = 4;
+  static constexpr Leg legs[legCount] = {
+    // Передняя левая
+    { { 0,  1, 90, -45, 45 }, { 1,  1, 90, -90, 90 }, { 2,  1, 0, 0, 160 }, 55.0f, 107.0f, 130.0f },
+    // Передняя правая
+    { { 3, -1, 90, -45, 45 }, { 4, -1, 90, -90, 90 }, { 5, -1, 180, 0, 160 }, 55.0f, 107.0f, 130.0f },
+    // Задняя левая
+    { { 6,  1, 90, -45, 45 }, { 7,  1, 90, -90, 90 }, { 8,  1, 0, 0, 160 }, 55.0f, 107.0f, 130.0f },
+    // Задняя правая
+    { { 9, -1, 90, -45, 45 }, { 10, -1, 90, -90, 90 }, { 11, -1, 180, 0, 160 }, 55.0f, 107.0f, 130.0f },
+  };
+};
+
+// Уменьшенный вариант: короче звенья, правые ноги разведены на каналы 9-15
+struct QuadSpotMini {
+  static constexpr const char* name = "QuadSpotMini";
+  static constexpr uint8_t legCount = 4;
+  static constexpr Leg legs[legCount] = {
+    // Передняя левая
+    { { 0,  1, 90, -35, 35 }, { 1,  1, 90, -80, 80 }, { 2,  1, 0, 0, 150 }, 40.0f, 80.0f, 95.0f },
+    // Передняя правая
+    { { 15, -1, 90, -35, 35 }, { 14, -1, 90, -80, 80 }, { 13, -1, 180, 0, 150 }, 40.0f, 80.0f, 95.0f },
+    // Задняя левая
+    { { 4,  1, 90, -35, 35 }, { 5,  1, 90, -80, 80 }, { 6,  1, 0, 0, 150 }, 40.0f, 80.0f, 95.0f },
+    // Задняя правая
+    { { 11, -1, 90, -35, 35 }, { 10, -1, 90, -80, 80 }, { 9, -1, 180, 0, 150 }, 40.0f, 80.0f, 95.0f },
+  };
+};
+
+// Проверка сустава: канал PCA9685, направление и пределы
+constexpr bool isValidJoint(const Joint& joint) {
+  return joint.channel < 16 &&
+         (joint.direction == 1 || joint.direction == -1) &&
+         joint.minAngle < joint.maxAngle &&
+         joint.neutral >= 0 && joint.neutral <= 180;
+}
+
+// Канал используется в описании не более одного раза
+template <class Robot>
+constexpr uint8_t channelUseCount(uint8_t channel) {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < Robot::legCount; i++) {
+    count += Robot::legs[i].coxa.channel == channel;
+    count += Robot::legs[i].femur.channel == channel;
+    count += Robot::legs[i].tibia.channel == channel;
+  }
+  return count;
+}
+
+// Проверка всего описания на этапе компиляции
+template <class Robot>
+constexpr bool isValidRobot() {
+  for (uint8_t i = 0; i < Robot::legCount; i++) {
+    const Leg& leg = Robot::legs[i];
+    if (!isValidJoint(leg.coxa) || !isValidJoint(leg.femur) || !isValidJoint(leg.tibia)) {
+      return false;
+    }
+    if (leg.coxaLength <= 0 || leg.femurLength <= 0 || leg.tibiaLength <= 0) {
+      return false;
+    }
+  }
+  for (uint8_t channel = 0; channel < 16; channel++) {
+    if (channelUseCount<Robot>(channel) > 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Оба варианта проверяются в каждой сборке
+static_assert(isValidRobot<QuadSpot>(), "QuadSpot: invalid robot description");
+static_assert(isValidRobot<QuadSpotMini>(), "QuadSpotMini: invalid robot description");
+
+} // namespace robot
+
+// Вариант робота для этой сборки
+#if defined(ROBOT_VARIANT_QUADSPOT_MINI)
+typedef robot::QuadSpotMini ActiveRobotDescription;
+#else
+typedef robot::QuadSpot ActiveRobotDescription;
+#endif
+
+#endif // ROBOT_DESCRIPTION_H
\ No newline at end of file
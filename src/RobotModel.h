@@ -0,0 +1,165 @@
+#ifndef ROBOT_MODEL_H
+#define ROBOT_MODEL_H
+
+#include <Arduino.h>
+#include <math.h>
+#include <utility>
+#include "RobotDescription.h"
+#include "MotionScheduler.h"
+
+// Положение стопы в системе координат плеча ноги, мм:
+// x - вперед, y - наружу от корпуса, z - вниз
+struct FootTarget {
+  float x;
+  float y;
+  float z;
+};
+
+// Углы суставов ноги, градусы (0 - нейтральное положение)
+struct LegAngles {
+  float coxa;
+  float femur;
+  float tibia;
+};
+
+// Кинематика и выдача позы, специализированные под описание робота.
+// Номер ноги - параметр шаблона, поэтому длины звеньев, каналы,
+// направления и пределы подставляются константами, а циклы по ногам
+// разворачиваются компилятором. Калибровка импульсов по-прежнему
+// выполняется в ServoController во время работы.
+template <class Robot>
+class RobotModel {
+public:
+  static constexpr uint8_t legCount = Robot::legCount;
+
+  // Обратная кинематика одной ноги; false - точка недостижима
+  template <uint8_t L>
+  static bool solveLeg(const FootTarget& foot, LegAngles& angles) {
+    static_assert(L < Robot::legCount, "leg index out of range");
+    constexpr float l1 = Robot::legs[L].coxaLength;
+    constexpr float l2 = Robot::legs[L].femurLength;
+    constexpr float l3 = Robot::legs[L].tibiaLength;
+
+    // Отведение: в плоскости y-z звено coxa смещает плоскость ноги на l1
+    float yz2 = foot.y * foot.y + foot.z * foot.z;
+    if (yz2 < l1 * l1) {
+      return false;
+    }
+    float f = sqrtf(yz2 - l1 * l1);
+    float coxa = atan2f(foot.z, foot.y) - atan2f(f, l1);
+
+    // Бедро и голень: двухзвенник в плоскости ноги
+    float d2 = foot.x * foot.x + f * f;
+    float d = sqrtf(d2);
+    if (d > l2 + l3 || d < fabsf(l2 - l3)) {
+      return false;
+    }
+    float knee = acosf((l2 * l2 + l3 * l3 - d2) / (2.0f * l2 * l3));
+    float hip = atan2f(foot.x, f) + acosf((l2 * l2 + d2 - l3 * l3) / (2.0f * l2 * d));
+
+    angles.coxa = coxa * RAD_TO_DEG;
+    angles.femur = hip * RAD_TO_DEG;
+    angles.tibia = 180.0f - knee * RAD_TO_DEG;
+    return true;
+  }
+
+  // Обратная кинематика всех ног; false - хотя бы одна точка недостижима
+  static bool solve(const FootTarget (&feet)[Robot::legCount],
+                    LegAngles (&angles)[Robot::legCount]) {
+    return solveAll(feet, angles, std::make_integer_sequence<uint8_t, Robot::legCount>());
+  }
+
+  // Угол сервопривода для угла сустава с учетом пределов и направления
+  static int jointToServo(const robot::Joint& joint, float angle) {
+    angle = constrain(angle, (float)joint.minAngle, (float)joint.maxAngle);
+    int servo = joint.neutral + joint.direction * (int)lroundf(angle);
+    return constrain(servo, 0, 180);
+  }
+
+  // Решение и выдача позы; если хоть одна точка недостижима, поза не меняется
+  static bool moveFeet(MotionScheduler& scheduler, const FootTarget (&feet)[Robot::legCount]) {
+    LegAngles angles[Robot::legCount];
+    if (!solve(feet, angles)) {
+      return false;
+    }
+    commit(scheduler, angles);
+    return true;
+  }
+
+  // Стойка: стопы под плечами ног на высоте height, мм
+  static void standingFeet(float height, FootTarget (&feet)[Robot::legCount]) {
+    for (uint8_t i = 0; i < Robot::legCount; i++) {
+      feet[i] = { 0.0f, Robot::legs[i].coxaLength, height };
+    }
+  }
+
+  // Пределы угла сервопривода, соответствующие пределам сустава
+  static constexpr int servoMin(const robot::Joint& joint) {
+    return clampServo(joint.neutral + joint.direction *
+                      (joint.direction > 0 ? joint.minAngle : joint.maxAngle));
+  }
+  static constexpr int servoMax(const robot::Joint& joint) {
+    return clampServo(joint.neutral + joint.direction *
+                      (joint.direction > 0 ? joint.maxAngle : joint.minAngle));
+  }
+
+  // Выдача позы всех ног через планировщик (с учетом бюджета тока)
+  static void commit(MotionScheduler& scheduler, const LegAngles (&angles)[Robot::legCount]) {
+    commitAll(scheduler, angles, std::make_integer_sequence<uint8_t, Robot::legCount>());
+  }
+
+  // Передача пределов суставов планировщику: любые команды (WebSocket,
+  // UDP, траектории) не выводят сустав за пределы описания робота
+  static void applyLimits(MotionScheduler& scheduler) {
+    limitAll(scheduler, std::make_integer_sequence<uint8_t, Robot::legCount>());
+  }
+
+private:
+  static constexpr int clampServo(int angle) {
+    return angle < 0 ? 0 : (angle > 180 ? 180 : angle);
+  }
+
+  template <uint8_t... L>
+  static bool solveAll(const FootTarget (&feet)[Robot::legCount],
+                       LegAngles (&angles)[Robot::legCount],
+                       std::integer_sequence<uint8_t, L...>) {
+    // Развертывание по ногам без цикла во время работы; решаются все ноги
+    return (true & ... & solveLeg<L>(feet[L], angles[L]));
+  }
+
+  template <uint8_t L>
+  static void commitLeg(MotionScheduler& scheduler, const LegAngles& angles) {
+    constexpr robot::Leg leg = Robot::legs[L];
+    scheduler.moveTo(leg.coxa.channel, jointToServo(leg.coxa, angles.coxa));
+    scheduler.moveTo(leg.femur.channel, jointToServo(leg.femur, angles.femur));
+    scheduler.moveTo(leg.tibia.channel, jointToServo(leg.tibia, angles.tibia));
+  }
+
+  template <uint8_t... L>
+  static void commitAll(MotionScheduler& scheduler, const LegAngles (&angles)[Robot::legCount],
+                        std::integer_sequence<uint8_t, L...>) {
+    (commitLeg<L>(scheduler, angles[L]), ...);
+  }
+
+  static void limitJoint(MotionScheduler& scheduler, const robot::Joint& joint) {
+    scheduler.setAngleLimits(joint.channel, servoMin(joint), servoMax(joint));
+  }
+
+  template <uint8_t L>
+  static void limitLeg(MotionScheduler& scheduler) {
+    constexpr robot::Leg leg = Robot::legs[L];
+    limitJoint(scheduler, leg.coxa);
+    limitJoint(scheduler, leg.femur);
+    limitJoint(scheduler, leg.tibia);
+  }
+
+  template <uint8_t... L>
+  static void limitAll(MotionScheduler& scheduler, std::integer_sequence<uint8_t, L...>) {
+    (limitLeg<L>(scheduler), ...);
+  }
+};
+
+// Модель робота для этой сборки
+typedef RobotModel<ActiveRobotDescription> ActiveRobot;
+
+#endif // ROBOT_MODEL_H
\ No newline at end of file
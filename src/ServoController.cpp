@@ -1,8 +1,14 @@
 #include "ServoController.h"
+#include "FlightRecorder.h"
+#include "Logger.h"
 
 // Конструктор
 ServoController::ServoController(int sda_pin, int scl_pin, uint8_t pca_addr) 
-  : _sda_pin(sda_pin), _scl_pin(scl_pin), _pca_addr(pca_addr), _pwm(pca_addr), _freq(50) {
+  : _pwm(pca_addr), _sda_pin(sda_pin), _scl_pin(scl_pin), _pca_addr(pca_addr), _freq(50),
+    _configGeneration(0) {
+  for (uint8_t i = 0; i < MAX_SERVOS; i++) {
+    _lastCommitUs[i] = 0;
+  }
 }
 
 // Инициализация
@@ -21,6 +27,7 @@ void ServoController::begin(uint8_t freq) {
     _servoConfigs[i].maxPulse = DEFAULT_MAX_PULSE;
     _servoConfigs[i].centerOffset = 0;
     _servoConfigs[i].currentPos = 90;  // По умолчанию центр
+    _servoConfigs[i].loadClass = DEFAULT_LOAD_CLASS;
     _servoConfigs[i].name = "Servo " + String(i + 1);
   }
   
@@ -67,10 +74,20 @@ int ServoController::angleToPulse(uint8_t servoIndex, int angle) {
 }
 
 // Установка позиции сервопривода
-void ServoController::setPosition(uint8_t servoIndex, int angle) {
+void ServoController::setPosition(uint8_t servoIndex, int angle, bool record) {
   if (servoIndex < MAX_SERVOS) {
     int pulse = angleToPulse(servoIndex, angle);
+    if (record) {
+      flightRecorder.record(FR_EVENT_POSE, servoIndex, _servoConfigs[servoIndex].currentPos, pulse);
+    }
+    
+    uint32_t start = micros();
     _pwm.setPWM(servoIndex, 0, pulse);
+    uint32_t end = micros();
+    _lastCommitUs[servoIndex] = end;
+    if (record) {
+      flightRecorder.record(FR_EVENT_PWM_COMMIT, servoIndex, pulse, end - start);
+    }
   }
 }
 
@@ -89,18 +106,29 @@ int ServoController::getCurrentPosition(uint8_t servoIndex) const {
   return 0;
 }
 
+// Время завершения последней записи в PCA9685 (micros)
+uint32_t ServoController::getLastCommitMicros(uint8_t servoIndex) const {
+  if (servoIndex < MAX_SERVOS) {
+    return _lastCommitUs[servoIndex];
+  }
+  return 0;
+}
+
 // Калибровка сервопривода
 void ServoController::calibrateServo(uint8_t servoIndex, int minPulse, 
                                     int maxPulse, int centerOffset, 
-                                    const String& name) {
+                                    const String& name, bool persist) {
   if (servoIndex < MAX_SERVOS) {
     _servoConfigs[servoIndex].minPulse = minPulse;
     _servoConfigs[servoIndex].maxPulse = maxPulse;
     _servoConfigs[servoIndex].centerOffset = centerOffset;
     _servoConfigs[servoIndex].name = name;
+    _configGeneration++;
     
-    // Сохраняем калибровку сразу в память
-    saveServoConfigToPreferences(servoIndex);
+    // Сохраняем калибровку сразу в память (при пакетном применении - позже, одной записью)
+    if (persist) {
+      saveServoConfigToPreferences(servoIndex);
+    }
     
     // Обновляем позицию сервопривода
     setPosition(servoIndex, _servoConfigs[servoIndex].currentPos);
@@ -119,30 +147,59 @@ ServoConfig ServoController::getServoConfig(uint8_t servoIndex) const {
   defaultConfig.maxPulse = DEFAULT_MAX_PULSE;
   defaultConfig.centerOffset = 0;
   defaultConfig.currentPos = 90;
+  defaultConfig.loadClass = DEFAULT_LOAD_CLASS;
   defaultConfig.name = "Invalid";
   return defaultConfig;
 }
 
+// Установка класса нагрузки сервопривода
+void ServoController::setLoadClass(uint8_t servoIndex, uint8_t loadClass, bool persist) {
+  if (servoIndex < MAX_SERVOS && loadClass <= LOAD_CLASS_HEAVY) {
+    _servoConfigs[servoIndex].loadClass = loadClass;
+    _configGeneration++;
+    
+    if (persist) {
+      saveServoConfigToPreferences(servoIndex);
+    }
+  }
+}
+
+// Получение класса нагрузки сервопривода
+uint8_t ServoController::getLoadClass(uint8_t servoIndex) const {
+  if (servoIndex < MAX_SERVOS) {
+    return _servoConfigs[servoIndex].loadClass;
+  }
+  return DEFAULT_LOAD_CLASS;
+}
+
 // Получение указателя на массив конфигураций всех сервоприводов
 ServoConfig* ServoController::getAllServoConfigs() {
   return _servoConfigs;
 }
 
+// Номер версии конфигурации (увеличивается при каждом изменении)
+uint32_t ServoController::getConfigGeneration() const {
+  return _configGeneration;
+}
+
 // Получение количества сервоприводов
 uint8_t ServoController::getServoCount() const {
   return MAX_SERVOS;
 }
 
 // Настройка частоты PWM
-void ServoController::setPWMFrequency(uint8_t freq) {
+void ServoController::setPWMFrequency(uint8_t freq, bool persist) {
   if (freq >= 40 && freq <= 1000) {  // Устанавливаем разумные ограничения
     _pwm.setPWMFreq(freq);
     _freq = freq;
+    _configGeneration++;
     
     // Сохраняем частоту в настройки
-    _preferences.begin("servo-config", false);
-    _preferences.putUInt("freq", freq);
-    _preferences.end();
+    if (persist) {
+      _preferences.begin("servo-config", false);
+      _preferences.putUInt("freq", freq);
+      _preferences.end();
+    }
   }
 }
 
@@ -154,22 +211,27 @@ uint8_t ServoController::getPWMFrequency() const {
 // Сохранение настроек конкретного сервопривода в память
 void ServoController::saveServoConfigToPreferences(uint8_t servoIndex) {
   _preferences.begin("servo-config", false);
-  
+  writeServoConfigToPreferences(servoIndex);
+  _preferences.end();
+}
+
+// Запись настроек сервопривода в уже открытое пространство Preferences
+void ServoController::writeServoConfigToPreferences(uint8_t servoIndex) {
   String prefix = "servo" + String(servoIndex) + "_";
-  char keyMin[20], keyMax[20], keyCenter[20], keyName[20];
+  char keyMin[20], keyMax[20], keyCenter[20], keyName[20], keyLoad[20];
   
   // Формируем ключи
   (prefix + "min").toCharArray(keyMin, sizeof(keyMin));
   (prefix + "max").toCharArray(keyMax, sizeof(keyMax));
   (prefix + "center").toCharArray(keyCenter, sizeof(keyCenter));
   (prefix + "name").toCharArray(keyName, sizeof(keyName));
+  (prefix + "load").toCharArray(keyLoad, sizeof(keyLoad));
   
   _preferences.putInt(keyMin, _servoConfigs[servoIndex].minPulse);
   _preferences.putInt(keyMax, _servoConfigs[servoIndex].maxPulse);
   _preferences.putInt(keyCenter, _servoConfigs[servoIndex].centerOffset);
   _preferences.putString(keyName, _servoConfigs[servoIndex].name);
-  
-  _preferences.end();
+  _preferences.putUChar(keyLoad, _servoConfigs[servoIndex].loadClass);
 }
 
 // Загрузка настроек конкретного сервопривода из памяти
@@ -177,18 +239,20 @@ void ServoController::loadServoConfigFromPreferences(uint8_t servoIndex) {
   _preferences.begin("servo-config", true);  // true = только для чтения
   
   String prefix = "servo" + String(servoIndex) + "_";
-  char keyMin[20], keyMax[20], keyCenter[20], keyName[20];
+  char keyMin[20], keyMax[20], keyCenter[20], keyName[20], keyLoad[20];
   
   // Формируем ключи
   (prefix + "min").toCharArray(keyMin, sizeof(keyMin));
   (prefix + "max").toCharArray(keyMax, sizeof(keyMax));
   (prefix + "center").toCharArray(keyCenter, sizeof(keyCenter));
   (prefix + "name").toCharArray(keyName, sizeof(keyName));
+  (prefix + "load").toCharArray(keyLoad, sizeof(keyLoad));
   
   _servoConfigs[servoIndex].minPulse = _preferences.getInt(keyMin, DEFAULT_MIN_PULSE);
   _servoConfigs[servoIndex].maxPulse = _preferences.getInt(keyMax, DEFAULT_MAX_PULSE);
   _servoConfigs[servoIndex].centerOffset = _preferences.getInt(keyCenter, 0);
   _servoConfigs[servoIndex].name = _preferences.getString(keyName, "Servo " + String(servoIndex + 1));
+  _servoConfigs[servoIndex].loadClass = _preferences.getUChar(keyLoad, DEFAULT_LOAD_CLASS);
   
   _preferences.end();
 }
@@ -203,14 +267,14 @@ void ServoController::saveSettings() {
   // Сохраняем частоту PWM
   _preferences.putUInt("freq", _freq);
   
-  _preferences.end();
-  
-  // Сохраняем настройки каждого сервопривода
+  // Сохраняем настройки каждого сервопривода в той же сессии
   for (uint8_t i = 0; i < MAX_SERVOS; i++) {
-    saveServoConfigToPreferences(i);
+    writeServoConfigToPreferences(i);
   }
   
-  Serial.println("Настройки сервоприводов сохранены в память");
+  _preferences.end();
+  
+  LOG_INFO("Настройки сервоприводов сохранены в память");
 }
 
 // Загрузка всех настроек из памяти
@@ -221,7 +285,7 @@ void ServoController::loadSettings() {
   bool hasSettings = _preferences.getBool("hasSettings", false);
   if (!hasSettings) {
     _preferences.end();
-    Serial.println("Сохраненных настроек не найдено, используем значения по умолчанию");
+    LOG_WARN("Сохраненных настроек не найдено, используем значения по умолчанию");
     return;
   }
   
@@ -235,6 +299,7 @@ void ServoController::loadSettings() {
   for (uint8_t i = 0; i < MAX_SERVOS; i++) {
     loadServoConfigFromPreferences(i);
   }
+  _configGeneration++;
   
-  Serial.println("Настройки сервоприводов загружены из памяти");
+  LOG_INFO("Настройки сервоприводов загружены из памяти");
 }
\ No newline at end of file
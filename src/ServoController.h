@@ -11,12 +11,19 @@
 #define DEFAULT_MAX_PULSE 600    // ~180 градусов
 #define DEFAULT_CENTER_PULSE 375 // ~90 градусов
 
+// Классы нагрузки для оценки потребляемого тока
+#define LOAD_CLASS_LIGHT 0
+#define LOAD_CLASS_MEDIUM 1
+#define LOAD_CLASS_HEAVY 2
+#define DEFAULT_LOAD_CLASS LOAD_CLASS_MEDIUM
+
 // Структура для хранения настроек сервопривода
 struct ServoConfig {
   int minPulse;      // Минимальный импульс (0°)
   int maxPulse;      // Максимальный импульс (180°)
   int centerOffset;  // Коррекция центра (90°)
   int currentPos;    // Текущая позиция 
+  uint8_t loadClass; // Класс нагрузки (LOAD_CLASS_*)
   String name;       // Имя сервопривода
 };
 
@@ -29,34 +36,42 @@ public:
   void begin(uint8_t freq = 50);
   
   // Управление сервоприводами
-  void setPosition(uint8_t servoIndex, int angle);
+  // record = false: не писать шаг в бортовой журнал (промежуточные шаги планировщика)
+  void setPosition(uint8_t servoIndex, int angle, bool record = true);
   void setAllPositions(int angle);
   int getCurrentPosition(uint8_t servoIndex) const;
+  uint32_t getLastCommitMicros(uint8_t servoIndex) const;
   
   // Калибровка
+  // persist = false: изменить без записи в память (затем вызвать saveSettings)
   void calibrateServo(uint8_t servoIndex, int minPulse, int maxPulse, 
-                      int centerOffset, const String& name);
+                      int centerOffset, const String& name, bool persist = true);
   ServoConfig getServoConfig(uint8_t servoIndex) const;
+  void setLoadClass(uint8_t servoIndex, uint8_t loadClass, bool persist = true);
+  uint8_t getLoadClass(uint8_t servoIndex) const;
   
   // Доступ к массиву конфигураций
   ServoConfig* getAllServoConfigs();
   uint8_t getServoCount() const;
+  uint32_t getConfigGeneration() const;
   
   // Сохранение/загрузка
   void saveSettings();
   void loadSettings();
   
   // Настройка частоты
-  void setPWMFrequency(uint8_t freq);
+  void setPWMFrequency(uint8_t freq, bool persist = true);
   uint8_t getPWMFrequency() const;
   
 private:
   // Внутренние переменные и методы
   Adafruit_PWMServoDriver _pwm;
   ServoConfig _servoConfigs[16];
+  volatile uint32_t _lastCommitUs[16];  // micros() завершения последней записи по I2C
   Preferences _preferences;
   int _sda_pin, _scl_pin;
   uint8_t _pca_addr, _freq;
+  volatile uint32_t _configGeneration;  // Версия конфигурации
   static const uint8_t MAX_SERVOS = 16;
   
   // Преобразование угла в импульс
@@ -64,6 +79,7 @@ private:
   
   // Вспомогательные методы для работы с Preferences
   void saveServoConfigToPreferences(uint8_t servoIndex);
+  void writeServoConfigToPreferences(uint8_t servoIndex);
   void loadServoConfigFromPreferences(uint8_t servoIndex);
 };
 
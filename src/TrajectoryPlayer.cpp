@@ -0,0 +1,210 @@
+#include "TrajectoryPlayer.h"
+
+// Кадров между шагами медленного роста оценки смещения часов
+// (позволяет отслеживать дрейф часов, а не только минимум)
+#define TRAJ_OFFSET_LEAK_FRAMES 32
+// Спад пиковой задержки за кадр и запас над ней, мс
+#define TRAJ_PEAK_DECAY_MS 0.05f
+#define TRAJ_DELAY_MARGIN_MS 5.0f
+
+// Конструктор
+TrajectoryPlayer::TrajectoryPlayer(MotionScheduler* motionScheduler)
+  : _motionScheduler(motionScheduler),
+    _lastTick(0) {
+  reset();
+}
+
+// Сброс буфера и оценок
+void TrajectoryPlayer::reset() {
+  _head = 0;
+  _count = 0;
+  _active = false;
+  _hasOffset = false;
+  _offset = 0;
+  _offsetLeak = 0;
+  _delayPeak = 0;
+  _frameInterval = 0;
+  _delayDev = 0;
+  _playoutDelay = TRAJ_MIN_DELAY_MS;
+  _channelCount = 0;
+  _appliedCount = 0;
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+// Начало потока
+void TrajectoryPlayer::start() {
+  portENTER_CRITICAL(&_mux);
+  reset();
+  _active = true;
+  portEXIT_CRITICAL(&_mux);
+}
+
+// Остановка потока (сервоприводы остаются в последней позиции)
+void TrajectoryPlayer::stop() {
+  portENTER_CRITICAL(&_mux);
+  _active = false;
+  _count = 0;
+  portEXIT_CRITICAL(&_mux);
+}
+
+// Поток активен
+bool TrajectoryPlayer::isActive() const {
+  return _active;
+}
+
+// Прием кадра
+bool TrajectoryPlayer::pushFrame(uint32_t senderMs, const uint8_t* positions,
+                                 uint8_t count, uint32_t localMs) {
+  bool accepted = false;
+
+  portENTER_CRITICAL(&_mux);
+  if (_active) {
+    // Оценка смещения часов: минимальная наблюдаемая задержка
+    int32_t sample = (int32_t)(localMs - senderMs);
+    if (!_hasOffset || sample - _offset < 0) {
+      _offset = sample;
+      _hasOffset = true;
+    } else if (++_offsetLeak >= TRAJ_OFFSET_LEAK_FRAMES) {
+      _offsetLeak = 0;
+      _offset++;
+    }
+
+    // Превышение задержки над минимальной - мера джиттера. Пиковое значение
+    // держится и медленно спадает, чтобы редкие опоздания не вызывали
+    // повторных провалов воспроизведения
+    float excess = (float)(sample - _offset);
+    _delayDev += (fabsf(excess - _delayDev) - _delayDev) / 16.0f;
+    _delayPeak = max(excess, _delayPeak - TRAJ_PEAK_DECAY_MS);
+
+    // Кадр старше последнего в буфере опоздал: ждать его уже нельзя
+    uint8_t tail = (_head + _count + TRAJ_BUFFER_SIZE - 1) % TRAJ_BUFFER_SIZE;
+    if (_count > 0 && (int32_t)(senderMs - _frames[tail].senderMs) <= 0) {
+      _stats.late++;
+    } else {
+      if (_count == TRAJ_BUFFER_SIZE) {
+        _head = (_head + 1) % TRAJ_BUFFER_SIZE;
+        _count--;
+        _stats.overflows++;
+      }
+
+      // Период кадров: для интерполяции следующий кадр нужен уже в момент
+      // воспроизведения текущего, поэтому задержка включает период
+      if (_count > 0) {
+        float interval = (float)(senderMs - _frames[tail].senderMs);
+        _frameInterval += (min(interval, (float)TRAJ_MAX_DELAY_MS) - _frameInterval) / 8.0f;
+      }
+
+      // Новые каналы потока: в уже буферизованных кадрах их значения не было,
+      // поэтому до этого кадра они держат его значение, а не заполнитель
+      uint8_t channels = min(count, (uint8_t)TRAJ_SERVO_COUNT);
+      for (uint8_t k = 0; k < _count; k++) {
+        TrajectoryFrame& buffered = _frames[(_head + k) % TRAJ_BUFFER_SIZE];
+        for (uint8_t i = _channelCount; i < channels; i++) {
+          buffered.positions[i] = positions[i];
+        }
+      }
+      _channelCount = max(_channelCount, channels);
+
+      TrajectoryFrame& frame = _frames[(_head + _count) % TRAJ_BUFFER_SIZE];
+      frame.senderMs = senderMs;
+      for (uint8_t i = 0; i < TRAJ_SERVO_COUNT; i++) {
+        // Каналы, не переданные в кадре, сохраняют предыдущее значение
+        // (каналы за пределами потока планировщику не передаются)
+        frame.positions[i] = i < count ? positions[i]
+                           : (_count > 0 ? _frames[tail].positions[i] : 90);
+      }
+      _count++;
+      _stats.frames++;
+      accepted = true;
+    }
+  }
+  portEXIT_CRITICAL(&_mux);
+
+  return accepted;
+}
+
+// Расчет позиции на момент localMs
+bool TrajectoryPlayer::sample(uint32_t localMs, uint8_t* positions) {
+  bool ready = false;
+
+  portENTER_CRITICAL(&_mux);
+  if (_active && _count > 0) {
+    // Плавная подстройка задержки под джиттер, без скачков времени
+    float target = constrain(_frameInterval + _delayPeak + TRAJ_DELAY_MARGIN_MS,
+                             (float)TRAJ_MIN_DELAY_MS, (float)TRAJ_MAX_DELAY_MS);
+    if (target > _playoutDelay) {
+      _playoutDelay = min(target, _playoutDelay + 1.0f);
+    } else {
+      _playoutDelay = max(target, _playoutDelay - 0.25f);
+    }
+
+    // Момент воспроизведения в часах отправителя
+    uint32_t playoutMs = localMs - (uint32_t)_offset - (uint32_t)_playoutDelay;
+
+    // Отбрасываем кадры, которые уже полностью воспроизведены
+    while (_count >= 2 &&
+           (int32_t)(playoutMs - _frames[(_head + 1) % TRAJ_BUFFER_SIZE].senderMs) >= 0) {
+      _head = (_head + 1) % TRAJ_BUFFER_SIZE;
+      _count--;
+    }
+
+    const TrajectoryFrame& a = _frames[_head];
+    if ((int32_t)(playoutMs - a.senderMs) >= 0) {
+      if (_count == 1) {
+        // Следующий кадр не пришел вовремя - удерживаем последнюю позицию
+        if (playoutMs != a.senderMs) {
+          _stats.underruns++;
+        }
+        memcpy(positions, a.positions, TRAJ_SERVO_COUNT);
+      } else {
+        const TrajectoryFrame& b = _frames[(_head + 1) % TRAJ_BUFFER_SIZE];
+        float frac = (float)(playoutMs - a.senderMs) / (float)(b.senderMs - a.senderMs);
+        for (uint8_t i = 0; i < TRAJ_SERVO_COUNT; i++) {
+          positions[i] = (uint8_t)lroundf(a.positions[i] + (b.positions[i] - a.positions[i]) * frac);
+        }
+      }
+      ready = true;
+    }
+  }
+  portEXIT_CRITICAL(&_mux);
+
+  return ready;
+}
+
+// Такт воспроизведения
+void TrajectoryPlayer::update() {
+  unsigned long now = millis();
+  if (!_active || now - _lastTick < TRAJ_TICK_MS) {
+    return;
+  }
+  _lastTick = now;
+
+  uint8_t positions[TRAJ_SERVO_COUNT];
+  if (!sample(now, positions)) {
+    return;
+  }
+
+  // Передаем планировщику только изменившиеся каналы потока; каналы,
+  // которых нет в кадрах, остаются в своих позициях
+  portENTER_CRITICAL(&_mux);
+  uint8_t channels = _channelCount;
+  portEXIT_CRITICAL(&_mux);
+  for (uint8_t i = 0; i < channels; i++) {
+    if (i >= _appliedCount || positions[i] != _lastApplied[i]) {
+      _motionScheduler->moveTo(i, positions[i]);
+      _lastApplied[i] = positions[i];
+    }
+  }
+  _appliedCount = channels;
+}
+
+// Статистика
+TrajectoryStats TrajectoryPlayer::getStats() const {
+  portENTER_CRITICAL(&_mux);
+  TrajectoryStats stats = _stats;
+  stats.buffered = _count;
+  stats.playoutDelayMs = _playoutDelay;
+  stats.jitterMs = _delayDev;
+  portEXIT_CRITICAL(&_mux);
+  return stats;
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef TRAJECTORY_PLAYER_H
+#define TRAJECTORY_PLAYER_H
+
+#include <Arduino.h>
+#include "MotionScheduler.h"
+
+// Настройки по умолчанию
+#define TRAJ_BUFFER_SIZE 32     // Кадров в буфере воспроизведения
+#define TRAJ_TICK_MS 10         // Период воспроизведения, мс
+#define TRAJ_MIN_DELAY_MS 20    // Минимальная задержка воспроизведения, мс
+#define TRAJ_MAX_DELAY_MS 150   // Максимальная задержка воспроизведения, мс
+#define TRAJ_SERVO_COUNT 16
+
+// Кадр траектории с меткой времени отправителя
+struct TrajectoryFrame {
+  uint32_t senderMs;
+  uint8_t positions[TRAJ_SERVO_COUNT];
+};
+
+// Статистика воспроизведения
+struct TrajectoryStats {
+  uint16_t buffered;      // Кадров в буфере
+  float playoutDelayMs;   // Текущая задержка воспроизведения
+  float jitterMs;         // Оценка джиттера сети
+  uint32_t frames;        // Принято кадров
+  uint32_t late;          // Отброшено опоздавших или вне порядка
+  uint32_t overflows;     // Вытеснено из-за переполнения буфера
+  uint32_t underruns;     // Тактов без следующего кадра (удержание позиции)
+};
+
+// Воспроизведение потоковой траектории. Кадры складываются в буфер по
+// мере прихода, а позиция вычисляется с фиксированным периодом
+// интерполяцией между кадрами в часах отправителя, смещенных на оценку
+// разницы часов и адаптивную задержку воспроизведения.
+class TrajectoryPlayer {
+public:
+  TrajectoryPlayer(MotionScheduler* motionScheduler);
+
+  // Управление потоком
+  void start();
+  void stop();
+  bool isActive() const;
+
+  // Прием кадра (из обработчика WebSocket); localMs - время прихода
+  bool pushFrame(uint32_t senderMs, const uint8_t* positions, uint8_t count, uint32_t localMs);
+
+  // Расчет позиции на момент localMs; false - воспроизводить пока нечего
+  bool sample(uint32_t localMs, uint8_t* positions);
+
+  // Такт воспроизведения (вызывается из loop)
+  void update();
+
+  TrajectoryStats getStats() const;
+
+private:
+  MotionScheduler* _motionScheduler;
+  TrajectoryFrame _frames[TRAJ_BUFFER_SIZE];
+  uint8_t _head;              // Индекс самого старого кадра
+  uint8_t _count;
+  bool _active;
+  bool _hasOffset;
+  int32_t _offset;            // Оценка (локальное время - время отправителя), мс
+  uint16_t _offsetLeak;       // Счетчик кадров для медленного роста оценки
+  float _delayPeak;           // Пиковое превышение задержки над минимальной
+  float _delayDev;            // Среднее превышение задержки (оценка джиттера)
+  float _frameInterval;       // Средний период кадров отправителя, мс
+  float _playoutDelay;        // Текущая задержка воспроизведения, мс
+  uint8_t _channelCount;      // Каналов в потоке (наибольшее число в кадре)
+  uint8_t _lastApplied[TRAJ_SERVO_COUNT];
+  uint8_t _appliedCount;      // Каналов, уже переданных планировщику
+  unsigned long _lastTick;
+  TrajectoryStats _stats;
+  mutable portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+  void reset();
+};
+
+#endif // TRAJECTORY_PLAYER_H
\ No newline at end of file
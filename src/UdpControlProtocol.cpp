@@ -0,0 +1,88 @@
+#include "UdpControlProtocol.h"
+#include <string.h>
+
+// Конструктор
+UdpControlProtocol::UdpControlProtocol()
+  : _hasSeq(false),
+    _session(0),
+    _lastSeq(0),
+    _seen(0),
+    _lastPacketMs(0) {
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+// Проверка пакета
+bool UdpControlProtocol::accept(const uint8_t* data, size_t len, uint32_t token,
+                                uint32_t nowMs, UdpControlHeader& header) {
+  _stats.received++;
+
+  if (len < sizeof(header)) {
+    _stats.malformed++;
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+
+  size_t itemSize = header.type == UDP_PACKET_VELOCITY ? sizeof(int16_t) : sizeof(uint8_t);
+  if (header.magic[0] != 'Q' || header.magic[1] != 'S' ||
+      header.version != UDP_CONTROL_VERSION ||
+      (header.type != UDP_PACKET_POSE && header.type != UDP_PACKET_VELOCITY) ||
+      header.count > UDP_CONTROL_CHANNELS ||
+      len < sizeof(header) + header.count * itemSize) {
+    _stats.malformed++;
+    return false;
+  }
+
+  if (token != 0 && header.token != token) {
+    _stats.authFailed++;
+    return false;
+  }
+
+  // Перезапуск отправителя: новый сеанс, большой откат номера или долгая пауза
+  int32_t diff = (int32_t)(header.seq - _lastSeq);
+  bool idle = nowMs - _lastPacketMs > UDP_SEQ_IDLE_RESET_MS;
+  _lastPacketMs = nowMs;
+  if (!_hasSeq || header.session != _session || diff <= -UDP_SEQ_RESTART_WINDOW || idle) {
+    if (_hasSeq) {
+      _stats.restarts++;
+    }
+    restart(header);
+    _stats.accepted++;
+    return true;
+  }
+
+  if (diff <= 0) {
+    // Пакет старше последнего применяется уже поздно
+    uint32_t age = (uint32_t)-diff;
+    uint64_t bit = 1ULL << age;
+    if (age < UDP_SEQ_HISTORY && !(_seen & bit)) {
+      _seen |= bit;
+      _stats.lost--;
+      _stats.reordered++;
+    } else {
+      _stats.stale++;
+    }
+    return false;
+  }
+
+  // Пропущенные номера считаются потерянными, пока не придут
+  _stats.lost += diff - 1;
+  _seen = diff < UDP_SEQ_HISTORY ? (_seen << diff) | 1 : 1;
+  _lastSeq = header.seq;
+  _stats.accepted++;
+  return true;
+}
+
+// Начало нового потока номеров
+void UdpControlProtocol::restart(const UdpControlHeader& header) {
+  _hasSeq = true;
+  _session = header.session;
+  _lastSeq = header.seq;
+  // Номера до начала потока не ждем: опоздавший пакет считается устаревшим,
+  // а не найденным потерянным
+  _seen = ~0ULL;
+}
+
+// Счетчики канала
+const UdpControlStats& UdpControlProtocol::getStats() const {
+  return _stats;
+}
@@ -0,0 +1,72 @@
+#ifndef UDP_CONTROL_PROTOCOL_H
+#define UDP_CONTROL_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Настройки по умолчанию
+#define UDP_CONTROL_VERSION 1
+#define UDP_CONTROL_CHANNELS 16
+#define UDP_SEQ_RESTART_WINDOW 1000  // Откат номера больше этого - перезапуск отправителя
+#define UDP_SEQ_IDLE_RESET_MS 1000   // Пауза дольше этого - новый поток, номера с начала
+#define UDP_SEQ_HISTORY 64           // Окно номеров для учета переставленных пакетов
+
+// Типы пакетов
+enum UdpPacketType : uint8_t {
+  UDP_PACKET_POSE = 1,      // Полезная нагрузка: uint8_t угол[count]
+  UDP_PACKET_VELOCITY = 2   // Полезная нагрузка: int16_t град/с[count]
+};
+
+// Заголовок пакета (little-endian, 16 байт)
+struct __attribute__((packed)) UdpControlHeader {
+  char magic[2];      // "QS"
+  uint8_t version;    // UDP_CONTROL_VERSION
+  uint8_t type;       // UdpPacketType
+  uint32_t seq;       // Порядковый номер, растет с каждым пакетом
+  uint32_t token;     // Токен доступа (0, если проверка отключена)
+  uint8_t count;      // Количество каналов в нагрузке
+  uint8_t session;    // Случайный номер сеанса отправителя (0 - не задан)
+  uint8_t reserved[2];
+};
+
+// Счетчики канала
+struct UdpControlStats {
+  uint32_t received;    // Всего пакетов
+  uint32_t accepted;    // Применено
+  uint32_t lost;        // Пропущено номеров (потеряно в сети и не пришло позже)
+  uint32_t reordered;   // Пришли после более нового пакета (не применяются)
+  uint32_t stale;       // Повторные и слишком старые
+  uint32_t authFailed;  // Неверный токен
+  uint32_t malformed;   // Неверный формат
+  uint32_t restarts;    // Начато новых потоков номеров
+};
+
+// Проверка пакетов канала управления, без сетевого стека.
+// Принимается только номер новее последнего. Пакет, пришедший позже
+// более нового, сначала учтен как потерянный; если он все же пришел
+// в пределах окна UDP_SEQ_HISTORY, он переносится из потерянных
+// в переставленные. Новый номер сеанса, откат номера больше
+// UDP_SEQ_RESTART_WINDOW или пауза дольше UDP_SEQ_IDLE_RESET_MS
+// начинают поток номеров заново (перезапуск отправителя).
+class UdpControlProtocol {
+public:
+  UdpControlProtocol();
+
+  // Проверка пакета; true - пакет нужно применить, header заполнен
+  bool accept(const uint8_t* data, size_t len, uint32_t token, uint32_t nowMs,
+              UdpControlHeader& header);
+
+  const UdpControlStats& getStats() const;
+
+private:
+  bool _hasSeq;
+  uint8_t _session;
+  uint32_t _lastSeq;
+  uint64_t _seen;         // Бит i - принят номер _lastSeq - i
+  uint32_t _lastPacketMs;
+  UdpControlStats _stats;
+
+  void restart(const UdpControlHeader& header);
+};
+
+#endif // UDP_CONTROL_PROTOCOL_H
@@ -0,0 +1,171 @@
+#include "UdpControlServer.h"
+#include "FlightRecorder.h"
+#include "Logger.h"
+
+// Период интегрирования скорости, мс
+#define UDP_VELOCITY_TICK_MS 10
+
+// Конструктор
+UdpControlServer::UdpControlServer(ServoController* servoController,
+                                   MotionScheduler* motionScheduler)
+  : _servoController(servoController),
+    _motionScheduler(motionScheduler),
+    _port(UDP_CONTROL_PORT),
+    _listening(false),
+    _token(0),
+    _hasAccepted(false),
+    _lastAcceptedMs(0),
+    _hasPose(false),
+    _poseCount(0),
+    _hasVelocity(false),
+    _velocityCount(0),
+    _lastVelocityMs(0),
+    _velocityActive(false),
+    _lastTick(0) {
+}
+
+// Инициализация
+void UdpControlServer::begin(uint16_t port) {
+  _port = port;
+
+  _preferences.begin("udp-config", true);
+  _token = _preferences.getUInt("token", 0);
+  _preferences.end();
+}
+
+// Установка токена доступа
+void UdpControlServer::setToken(uint32_t token) {
+  portENTER_CRITICAL(&_mux);
+  _token = token;
+  portEXIT_CRITICAL(&_mux);
+
+  _preferences.begin("udp-config", false);
+  _preferences.putUInt("token", token);
+  _preferences.end();
+}
+
+// Обработка пакета (задача AsyncUDP): проверка и запись в почтовый ящик
+void UdpControlServer::handlePacket(AsyncUDPPacket& packet) {
+  const uint8_t* data = packet.data();
+  size_t len = packet.length();
+  UdpControlHeader header;
+
+  unsigned long now = millis();
+
+  portENTER_CRITICAL(&_mux);
+  if (!_protocol.accept(data, len, _token, now, header)) {
+    portEXIT_CRITICAL(&_mux);
+    return;
+  }
+  _hasAccepted = true;
+  _lastAcceptedMs = now;
+
+  const uint8_t* payload = data + sizeof(header);
+  if (header.type == UDP_PACKET_POSE) {
+    memcpy(_pose, payload, header.count);
+    _poseCount = header.count;
+    _hasPose = true;
+    _hasVelocity = false;
+  } else {
+    memcpy(_velocity, payload, header.count * sizeof(int16_t));
+    _velocityCount = header.count;
+    _hasVelocity = true;
+    _lastVelocityMs = now;
+  }
+  portEXIT_CRITICAL(&_mux);
+}
+
+// Применение принятых команд
+void UdpControlServer::update() {
+  // Прослушивание возможно только после запуска сетевого стека
+  if (!_listening && WiFi.getMode() != WIFI_OFF) {
+    if (_udp.listen(_port)) {
+      _udp.onPacket([this](AsyncUDPPacket packet) {
+        handlePacket(packet);
+      });
+      _listening = true;
+      LOG_INFO("UDP control listening on port %u", _port);
+    }
+  }
+
+  // Забираем содержимое почтового ящика
+  uint8_t pose[UDP_CONTROL_CHANNELS];
+  uint8_t poseCount = 0;
+  int16_t velocity[UDP_CONTROL_CHANNELS];
+  uint8_t velocityCount = 0;
+  bool velocityFresh = false;
+
+  portENTER_CRITICAL(&_mux);
+  if (_hasPose) {
+    memcpy(pose, _pose, _poseCount);
+    poseCount = _poseCount;
+    _hasPose = false;
+  }
+  if (_hasVelocity) {
+    memcpy(velocity, _velocity, _velocityCount * sizeof(int16_t));
+    velocityCount = _velocityCount;
+    velocityFresh = millis() - _lastVelocityMs <= UDP_VELOCITY_TIMEOUT_MS;
+    if (!velocityFresh) {
+      _hasVelocity = false;
+    }
+  }
+  portEXIT_CRITICAL(&_mux);
+
+  // Поза применяется сразу; скорость отменяется
+  if (poseCount > 0) {
+    _velocityActive = false;
+    for (uint8_t i = 0; i < poseCount; i++) {
+      _motionScheduler->moveTo(i, pose[i]);
+    }
+    flightRecorder.record(FR_EVENT_COMMAND, SRC_UDP, CMD_UDP_POSE);
+  }
+
+  // Интегрирование скорости с фиксированным периодом
+  unsigned long now = millis();
+  if (now - _lastTick < UDP_VELOCITY_TICK_MS) {
+    return;
+  }
+  float dt = min((now - _lastTick) / 1000.0f, UDP_VELOCITY_TICK_MS * 5 / 1000.0f);
+  _lastTick = now;
+
+  if (!velocityFresh) {
+    // Нет свежих команд скорости - останавливаемся там, где есть
+    _velocityActive = false;
+    return;
+  }
+
+  if (!_velocityActive) {
+    for (uint8_t i = 0; i < UDP_CONTROL_CHANNELS; i++) {
+      _positions[i] = _servoController->getCurrentPosition(i);
+    }
+    _velocityActive = true;
+  }
+
+  for (uint8_t i = 0; i < velocityCount; i++) {
+    if (velocity[i] == 0) continue;
+
+    _positions[i] = constrain(_positions[i] + velocity[i] * dt, 0.0f, 180.0f);
+    _motionScheduler->moveTo(i, (int)lroundf(_positions[i]));
+  }
+}
+
+// Счетчики канала
+UdpControlStats UdpControlServer::getStats() const {
+  portENTER_CRITICAL(&_mux);
+  UdpControlStats stats = _protocol.getStats();
+  portEXIT_CRITICAL(&_mux);
+  return stats;
+}
+
+// Прослушивание запущено
+bool UdpControlServer::isListening() const {
+  return _listening;
+}
+
+// Принимались ли команды недавно
+bool UdpControlServer::isActive() const {
+  portENTER_CRITICAL(&_mux);
+  bool active = _hasAccepted && millis() - _lastAcceptedMs <= UDP_ACTIVE_TIMEOUT_MS;
+  portEXIT_CRITICAL(&_mux);
+  return active;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef UDP_CONTROL_SERVER_H
+#define UDP_CONTROL_SERVER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <AsyncUDP.h>
+#include <Preferences.h>
+#include "MotionScheduler.h"
+#include "UdpControlProtocol.h"
+
+// Настройки по умолчанию
+#define UDP_CONTROL_PORT 4210
+#define UDP_VELOCITY_TIMEOUT_MS 250  // Без пакетов скорости дольше - остановка
+#define UDP_ACTIVE_TIMEOUT_MS 2000   // Канал активен, пока пакеты приходят чаще
+
+// Канал управления по UDP для телеуправления и потоковых походок.
+// Пакеты не ждут друг друга: опоздавшие и пришедшие вне порядка
+// отбрасываются, применяется только самый свежий. Приемник лишь кладет
+// пакет в почтовый ящик, применение выполняется в update() из loop.
+// Токен - простая защита от случайных отправителей, не криптография.
+class UdpControlServer {
+public:
+  UdpControlServer(ServoController* servoController, MotionScheduler* motionScheduler);
+
+  // Загрузка токена; прослушивание начинается, когда запущен WiFi
+  void begin(uint16_t port = UDP_CONTROL_PORT);
+
+  // Применение принятых команд (вызывается из loop)
+  void update();
+
+  // Токен доступа (0 - без проверки)
+  void setToken(uint32_t token);
+
+  UdpControlStats getStats() const;
+  bool isListening() const;
+
+  // Принимались ли команды за последние UDP_ACTIVE_TIMEOUT_MS
+  bool isActive() const;
+
+private:
+  ServoController* _servoController;
+  MotionScheduler* _motionScheduler;
+  AsyncUDP _udp;
+  Preferences _preferences;
+  uint16_t _port;
+  bool _listening;
+  uint32_t _token;
+
+  // Проверка пакетов и номеров
+  UdpControlProtocol _protocol;
+  bool _hasAccepted;
+  unsigned long _lastAcceptedMs;
+
+  // Почтовый ящик: последняя принятая команда
+  bool _hasPose;
+  uint8_t _pose[UDP_CONTROL_CHANNELS];
+  uint8_t _poseCount;
+  bool _hasVelocity;
+  int16_t _velocity[UDP_CONTROL_CHANNELS];
+  uint8_t _velocityCount;
+  unsigned long _lastVelocityMs;
+
+  // Интегрирование скорости
+  float _positions[UDP_CONTROL_CHANNELS];
+  bool _velocityActive;
+  unsigned long _lastTick;
+
+  mutable portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+  void handlePacket(AsyncUDPPacket& packet);
+};
+
+#endif // UDP_CONTROL_SERVER_H
\ No newline at end of file
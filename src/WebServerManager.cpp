@@ -1,18 +1,33 @@
 #include "WebServerManager.h"
+#include "FlightRecorder.h"
+#include "Logger.h"
+#include "RobotModel.h"
 
 // Инициализация статической переменной-указателя
 WebServerManager* WebServerManager::_instance = nullptr;
 
 // Конструктор
-WebServerManager::WebServerManager(ServoController* servoController)
+WebServerManager::WebServerManager(ServoController* servoController,
+                                   MotionScheduler* motionScheduler,
+                                   TrajectoryPlayer* trajectoryPlayer,
+                                   UdpControlServer* udpControl)
   : _servoController(servoController), 
+    _motionScheduler(motionScheduler),
+    _trajectoryPlayer(trajectoryPlayer),
+    _udpControl(udpControl),
     _server(80), 
     _ws("/ws"),
     _calibrationMode(false),
     _apMode(true),
     _ssid("AlashElectronics"),
     _password("28071917"),
-    _wsClient(nullptr) {
+    _wsClient(nullptr),
+    _lastTelemetry(0),
+    _configSnapshot(servoController, motionScheduler),
+    _radio(&_radioLink),
+    _workingRadioState(RADIO_MODEM_SLEEP),
+    _serverStarted(false),
+    _lastModeSwitchUs(0) {
   // Сохраняем указатель на экземпляр для использования в статических методах
   _instance = this;
 }
@@ -21,75 +36,120 @@ WebServerManager::WebServerManager(ServoController* servoController)
 bool WebServerManager::begin() {
   // Инициализация SPIFFS
   if (!SPIFFS.begin(true)) {
-    Serial.println("SPIFFS Mount Failed");
+    flightRecorder.record(FR_EVENT_FAULT, SRC_NONE, FAULT_SPIFFS_MOUNT);
+    LOG_ERROR("SPIFFS Mount Failed");
     return false;
   }
   
-  // Загружаем сохраненный режим
+  // Идентификатор загрузки делает ETag уникальным между перезагрузками
+  _configSnapshot.begin(esp_random());
+  
+  // Загружаем сохраненный режим и параметры связи
   _calibrationMode = loadMode();
+  _radio.configure(_ssid, _password, _apMode);
   
-  // Если режим калибровки, запускаем WiFi и веб-сервер
+  // Если режим калибровки, запускаем WiFi на полной мощности,
+  // иначе - в состоянии радио для рабочего режима
   if (_calibrationMode) {
-    return startCalibrationMode(_ssid.c_str(), _password.c_str(), _apMode);
+    return startCalibrationMode();
   }
   
+  applyRadioState(_workingRadioState);
   return true;
 }
 
-// Запуск режима калибровки
-bool WebServerManager::startCalibrationMode(const char* ssid, const char* password, bool apMode) {
-  _ssid = ssid;
-  _password = password;
-  _apMode = apMode;
-  
-  // Настройка WiFi
-  if (_apMode) {
-    // Режим точки доступа
-    WiFi.softAP(_ssid.c_str(), _password.c_str());
-    Serial.print("Access Point started. IP Address: ");
-    Serial.println(WiFi.softAPIP());
-  } else {
-    // Режим подключения к существующей сети
-    WiFi.begin(_ssid.c_str(), _password.c_str());
-    Serial.print("Statiom Point started.");
-    // Ждем подключения с таймаутом 20 секунд
-    unsigned long startTime = millis();
-    while (WiFi.status() != WL_CONNECTED && millis() - startTime < 20000) {
-      delay(500);
-      Serial.print(".");
-    }
-    
-    if (WiFi.status() != WL_CONNECTED) {
-      Serial.println("\nFailed to connect to WiFi");
-      return false;
-    }
-    
-    Serial.println("\nConnected to WiFi. IP Address: ");
-    Serial.println(WiFi.localIP());
-  }
+// Запуск режима калибровки с сохраненными параметрами сети
+bool WebServerManager::startCalibrationMode() {
+  uint32_t start = micros();
   
-  // Настройка веб-сервера
-  setupWebServer();
+  // Если связь сохранена в энергосбережении, достаточно поднять мощность.
+  // Подключение станции не блокирует: результат отслеживается в update()
+  _radio.configure(_ssid, _password, _apMode);
+  applyRadioState(RADIO_FULL_POWER);
   
   // Сохраняем режим
   _calibrationMode = true;
+  flightRecorder.record(FR_EVENT_MODE, SRC_NONE, 1);
   saveMode(_calibrationMode);
   
+  _lastModeSwitchUs = micros() - start;
   return true;
 }
 
+// Запуск режима калибровки с выбором режима сети
+bool WebServerManager::startCalibrationMode(bool apMode) {
+  setNetworkMode(apMode);
+  return startCalibrationMode();
+}
+
+// Выбор режима сети (AP или STA)
+void WebServerManager::setNetworkMode(bool apMode) {
+  _apMode = apMode;
+  
+  _preferences.begin("web-config", false);
+  _preferences.putBool("ap_mode", _apMode);
+  _preferences.end();
+  
+  // Подключение станции не блокирует: результат отслеживается в update()
+  _radio.configure(_ssid, _password, _apMode);
+}
+
+// Текущий режим сети
+bool WebServerManager::isApMode() const {
+  return _apMode;
+}
+
 // Остановка режима калибровки
 void WebServerManager::stopCalibrationMode() {
-  // Останавливаем веб-сервер и отключаем WiFi
-  _server.end();
-  WiFi.disconnect(true);
-  WiFi.mode(WIFI_OFF);
+  uint32_t start = micros();
+  
+  // Веб-сервер остается зарегистрированным, радио переходит в рабочее состояние
+  applyRadioState(_workingRadioState);
   
   // Сохраняем режим
   _calibrationMode = false;
+  flightRecorder.record(FR_EVENT_MODE, SRC_NONE, 0);
   saveMode(_calibrationMode);
   
-  Serial.println("Калибровочный режим остановлен");
+  _lastModeSwitchUs = micros() - start;
+  LOG_INFO("Калибровочный режим остановлен");
+}
+
+// Состояние радио в рабочем режиме (OFF или MODEM_SLEEP)
+void WebServerManager::setWorkingRadioState(RadioState state) {
+  if (state == RADIO_FULL_POWER) {
+    return;
+  }
+  
+  _workingRadioState = state;
+  
+  _preferences.begin("web-config", false);
+  _preferences.putUChar("radio_idle", _workingRadioState);
+  _preferences.end();
+  
+  if (!_calibrationMode) {
+    applyRadioState(_workingRadioState);
+  }
+}
+
+// Доступ к управлению радио (для статуса и телеметрии)
+const RadioPowerManager& WebServerManager::getRadio() const {
+  return _radio;
+}
+
+// Длительность последнего переключения режима
+uint32_t WebServerManager::getLastModeSwitchUs() const {
+  return _lastModeSwitchUs;
+}
+
+// Переход радио в состояние; веб-сервер регистрируется один раз при первом запуске сети
+void WebServerManager::applyRadioState(RadioState state) {
+  _radio.setState(state);
+  
+  if (state != RADIO_OFF && !_serverStarted) {
+    setupWebServer();
+    _serverStarted = true;
+  }
 }
 
 // Проверка текущего режима
@@ -97,7 +157,7 @@ bool WebServerManager::isCalibrationMode() const {
   return _calibrationMode;
 }
 
-// Настройка веб-сервера и обработчиков
+// Настройка веб-сервера и обработчиков (выполняется один раз)
 void WebServerManager::setupWebServer() {
   // Настройка WebSocket
   _ws.onEvent(onWebSocketEvent);
@@ -108,19 +168,65 @@ void WebServerManager::setupWebServer() {
     request->send(SPIFFS, "/index.html", "text/html");
   });
   
+  // Выгрузка бортового журнала (потоково, прямо из кольцевого буфера)
+  _server.on("/api/flightlog", HTTP_GET, [](AsyncWebServerRequest *request) {
+    FlightLogSnapshot snap = flightRecorder.snapshot();
+    AsyncWebServerResponse* response = request->beginChunkedResponse("application/octet-stream",
+      [snap](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+        return flightRecorder.read(snap, index, buffer, maxLen);
+      });
+    response->addHeader("Content-Disposition", "attachment; filename=\"flightlog.bin\"");
+    request->send(response);
+  });
+  
+  // Конфигурация целиком: чтение с поддержкой ETag и пакетная запись
+  _server.on("/api/config", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    handleGetConfig(request);
+  });
+  _server.on("/api/config", HTTP_PUT,
+    [this](AsyncWebServerRequest *request) {
+      handlePutConfig(request);
+    },
+    nullptr,
+    [this](AsyncWebServerRequest *request, uint8_t* data, size_t len, size_t index, size_t total) {
+      handlePutConfigBody(request, data, len, index, total);
+    });
+  
   // Обработчик статических файлов
   _server.serveStatic("/", SPIFFS, "/");
   
   // Запуск сервера
   _server.begin();
   
-  Serial.println("Web server started");
+  LOG_INFO("Web server started");
 }
 
 // Периодические задачи
 void WebServerManager::update() {
-  if (_calibrationMode) {
+  // Завершение трассировки команд, дошедших до PCA9685
+  _latencyTracer.update(_servoController, _motionScheduler);
+  
+  // Отслеживание подключения станции
+  _radio.update();
+  
+  // Энергосбережение радио добавляет задержку приема, поэтому пока идут
+  // команды по UDP, радио держится на полной мощности
+  if (!_calibrationMode && _workingRadioState == RADIO_MODEM_SLEEP) {
+    RadioState state = _udpControl->isActive() ? RADIO_FULL_POWER : RADIO_MODEM_SLEEP;
+    if (_radio.getState() != state) {
+      applyRadioState(state);
+    }
+  }
+  
+  if (_serverStarted && _radio.getState() != RADIO_OFF) {
     _ws.cleanupClients();
+    
+    // Периодическая рассылка телеметрии подключенным клиентам
+    unsigned long now = millis();
+    if (_ws.count() > 0 && now - _lastTelemetry >= TELEMETRY_INTERVAL_MS) {
+      _lastTelemetry = now;
+      sendTelemetry(nullptr);
+    }
   }
 }
 
@@ -130,8 +236,12 @@ void WebServerManager::onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketCl
   if (_instance) {
     switch (type) {
       case WS_EVT_CONNECT:
-        Serial.printf("WebSocket client #%u connected from %s\n", client->id(), 
-                     client->remoteIP().toString().c_str());
+        {
+          // Адрес передается числами: строка String не доживет до вывода
+          IPAddress ip = client->remoteIP();
+          LOG_INFO("WebSocket client #%u connected from %u.%u.%u.%u", client->id(),
+                   ip[0], ip[1], ip[2], ip[3]);
+        }
         // Сохраняем указатель на клиент
         _instance->_wsClient = client;
         // Отправляем текущую конфигурацию
@@ -139,7 +249,7 @@ void WebServerManager::onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketCl
         break;
         
       case WS_EVT_DISCONNECT:
-        Serial.printf("WebSocket client #%u disconnected\n", client->id());
+        LOG_INFO("WebSocket client #%u disconnected", client->id());
         // Если это был наш активный клиент, сбрасываем указатель
         if (_instance->_wsClient == client) {
           _instance->_wsClient = nullptr;
@@ -149,7 +259,7 @@ void WebServerManager::onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketCl
       case WS_EVT_DATA:
         // Обновляем указатель на клиент и обрабатываем сообщение
         _instance->_wsClient = client;
-        _instance->handleWebSocketMessage(client, arg, data, len);
+        _instance->handleWebSocketMessage(client, arg, data, len, micros());
         break;
         
       case WS_EVT_PONG:
@@ -161,7 +271,8 @@ void WebServerManager::onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketCl
 
 // Обработка WebSocket сообщений
 void WebServerManager::handleWebSocketMessage(AsyncWebSocketClient* client, 
-                                           void* arg, uint8_t* data, size_t len) {
+                                           void* arg, uint8_t* data, size_t len,
+                                           uint32_t rxUs) {
   AwsFrameInfo *info = (AwsFrameInfo*)arg;
   if (info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT) {
     data[len] = 0; // Добавляем нуль-терминатор для корректной работы с строкой
@@ -171,21 +282,39 @@ void WebServerManager::handleWebSocketMessage(AsyncWebSocketClient* client,
     DeserializationError error = deserializeJson(doc, message);
     
     if (error) {
-      Serial.print("deserializeJson() failed: ");
-      Serial.println(error.c_str());
+      flightRecorder.record(FR_EVENT_FAULT, SRC_WEBSOCKET, FAULT_JSON_PARSE, error.code());
+      // c_str() указывает на статическую строку ArduinoJson
+      LOG_WARN("deserializeJson() failed: %s", error.c_str());
       return;
     }
     
+    // Команда разобрана и передается на исполнение
+    uint32_t dispatchUs = micros();
+    uint32_t seq = doc["seq"] | 0;
+    
     // Обработка команд
     String command = doc["command"];
     
-    if (command == "getConfig") {
+    if (command == "ping") {
+      // Проба задержки: отвечаем сразу, с длительностью разбора на устройстве
+      JsonDocument respDoc;
+      respDoc["command"] = "pong";
+      respDoc["parseUs"] = dispatchUs - rxUs;
+      
+      sendResponse(client, respDoc, doc);
+    }
+    else if (command == "getConfig") {
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_GET_CONFIG);
       sendCurrentConfig(client);
     }
     else if (command == "setPosition") {
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_SET_POSITION);
       int servoIndex = doc["servoIndex"];
       int angle = doc["angle"];
-      _servoController->setPosition(servoIndex, angle);
+      // Трассируем, только если будет запись в PCA9685
+      if (_motionScheduler->moveTo(servoIndex, angle)) {
+        _latencyTracer.begin(seq, servoIndex, rxUs, dispatchUs);
+      }
       
       // Подтверждение установки позиции
       JsonDocument respDoc;
@@ -194,11 +323,10 @@ void WebServerManager::handleWebSocketMessage(AsyncWebSocketClient* client,
       respDoc["servoIndex"] = servoIndex;
       respDoc["angle"] = angle;
       
-      String response;
-      serializeJson(respDoc, response);
-      client->text(response);
+      sendResponse(client, respDoc, doc);
     }
     else if (command == "calibrate") {
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_CALIBRATE);
       int servoIndex = doc["servoIndex"];
       
       if (doc["minPulse"].is<int>()) {
@@ -220,68 +348,83 @@ void WebServerManager::handleWebSocketMessage(AsyncWebSocketClient* client,
         _servoController->calibrateServo(servoIndex, minPulse, maxPulse, centerOffset, name);
       }
       
+      if (doc["loadClass"].is<int>()) {
+        _servoController->setLoadClass(servoIndex, doc["loadClass"].as<int>());
+      }
+      
       JsonDocument respDoc;
       respDoc["status"] = "ok";
       respDoc["command"] = "calibrated";
       respDoc["servoIndex"] = servoIndex;
       
-      String response;
-      serializeJson(respDoc, response);
-      client->text(response);
+      sendResponse(client, respDoc, doc);
     }
     else if (command == "setAllPositions") {
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_SET_ALL_POSITIONS);
       JsonArray positions = doc["positions"];
       uint8_t index = 0;
+      int traced = -1;
       
       for (JsonVariant value : positions) {
         if (index < _servoController->getServoCount()) {
-          _servoController->setPosition(index, value.as<int>());
+          if (_motionScheduler->moveTo(index, value.as<int>()) && traced < 0) {
+            traced = index;
+          }
           index++;
         }
       }
+      // Трассируем первый канал, цель которого изменилась
+      if (traced >= 0) {
+        _latencyTracer.begin(seq, traced, rxUs, dispatchUs);
+      }
       
       JsonDocument respDoc;
       respDoc["status"] = "ok";
       respDoc["command"] = "allPositionsSet";
       
-      String response;
-      serializeJson(respDoc, response);
-      client->text(response);
+      sendResponse(client, respDoc, doc);
     }
     else if (command == "centerAll") {
-      _servoController->setAllPositions(90);
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_CENTER_ALL);
+      int traced = _motionScheduler->moveAll(90);
+      if (traced >= 0) {
+        _latencyTracer.begin(seq, traced, rxUs, dispatchUs);
+      }
       
       JsonDocument respDoc;
       respDoc["status"] = "ok";
       respDoc["command"] = "allCentered";
       
-      String response;
-      serializeJson(respDoc, response);
-      client->text(response);
+      sendResponse(client, respDoc, doc);
     }
     else if (command == "minAll") {
-      _servoController->setAllPositions(0);
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_MIN_ALL);
+      int traced = _motionScheduler->moveAll(0);
+      if (traced >= 0) {
+        _latencyTracer.begin(seq, traced, rxUs, dispatchUs);
+      }
       
       JsonDocument respDoc;
       respDoc["status"] = "ok";
       respDoc["command"] = "allMin";
       
-      String response;
-      serializeJson(respDoc, response);
-      client->text(response);
+      sendResponse(client, respDoc, doc);
     }
     else if (command == "maxAll") {
-      _servoController->setAllPositions(180);
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_MAX_ALL);
+      int traced = _motionScheduler->moveAll(180);
+      if (traced >= 0) {
+        _latencyTracer.begin(seq, traced, rxUs, dispatchUs);
+      }
       
       JsonDocument respDoc;
       respDoc["status"] = "ok";
       respDoc["command"] = "allMax";
       
-      String response;
-      serializeJson(respDoc, response);
-      client->text(response);
+      sendResponse(client, respDoc, doc);
     }
     else if (command == "setFrequency") {
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_SET_FREQUENCY);
       int freq = doc["frequency"];
       _servoController->setPWMFrequency(freq);
       
@@ -290,54 +433,311 @@ void WebServerManager::handleWebSocketMessage(AsyncWebSocketClient* client,
       respDoc["command"] = "frequencySet";
       respDoc["frequency"] = freq;
       
-      String response;
-      serializeJson(respDoc, response);
-      client->text(response);
+      sendResponse(client, respDoc, doc);
     }
     else if (command == "saveSettings") {
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_SAVE_SETTINGS);
       _servoController->saveSettings();
       
       JsonDocument respDoc;
       respDoc["status"] = "ok";
       respDoc["command"] = "settingsSaved";
       
-      String response;
-      serializeJson(respDoc, response);
-      client->text(response);
+      sendResponse(client, respDoc, doc);
+    }
+    else if (command == "setCurrentBudget") {
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_SET_CURRENT_BUDGET);
+      int budget = doc["budget"];
+      _motionScheduler->setCurrentBudget(constrain(budget, 0, 65535));
+      _motionScheduler->resetPeakCurrent();
+      sendTelemetry(client);
+    }
+    else if (command == "trajFrame") {
+      // Кадр потоковой траектории: ts - время отправителя, мс
+      uint8_t positions[TRAJ_SERVO_COUNT];
+      uint8_t count = 0;
+      for (JsonVariant value : doc["positions"].as<JsonArray>()) {
+        if (count < TRAJ_SERVO_COUNT) {
+          positions[count++] = constrain(value.as<int>(), 0, 180);
+        }
+      }
+      _trajectoryPlayer->pushFrame(doc["ts"].as<uint32_t>(), positions, count, millis());
+    }
+    else if (command == "trajStart") {
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_TRAJ_START);
+      _trajectoryPlayer->start();
+      
+      JsonDocument respDoc;
+      respDoc["status"] = "ok";
+      respDoc["command"] = "trajStarted";
+      
+      sendResponse(client, respDoc, doc);
+    }
+    else if (command == "trajStop") {
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_TRAJ_STOP);
+      _trajectoryPlayer->stop();
+      
+      JsonDocument respDoc;
+      respDoc["status"] = "ok";
+      respDoc["command"] = "trajStopped";
+      
+      sendResponse(client, respDoc, doc);
+    }
+    else if (command == "setFeet") {
+      // Положения стоп всех ног в системе координат плеча, мм: [[x, y, z], ...]
+      flightRecorder.record(FR_EVENT_COMMAND, SRC_WEBSOCKET, CMD_SET_FEET);
+      JsonArray feetArray = doc["feet"];
+      FootTarget feet[ActiveRobot::legCount];
+      bool valid = feetArray.size() == ActiveRobot::legCount;
+      
+      for (uint8_t i = 0; valid && i < ActiveRobot::legCount; i++) {
+        JsonArray foot = feetArray[i];
+        valid = foot.size() == 3;
+        feet[i] = { foot[0].as<float>(), foot[1].as<float>(), foot[2].as<float>() };
+      }
+      
+      JsonDocument respDoc;
+      respDoc["command"] = "feetSet";
+      if (valid && ActiveRobot::moveFeet(*_motionScheduler, feet)) {
+        respDoc["status"] = "ok";
+      } else {
+        // Неверный формат или точка вне досягаемости: поза не меняется
+        respDoc["status"] = "unreachable";
+      }
+      
+      sendResponse(client, respDoc, doc);
+    }
+    else if (command == "getTelemetry") {
+      sendTelemetry(client);
+    }
+    else {
+      flightRecorder.record(FR_EVENT_FAULT, SRC_WEBSOCKET, FAULT_UNKNOWN_COMMAND);
     }
   }
 }
 
+// Отправка ответа с эхом номера и метки времени команды клиента
+void WebServerManager::sendResponse(AsyncWebSocketClient* client, JsonDocument& respDoc,
+                                    const JsonDocument& request) {
+  if (!request["seq"].isNull()) {
+    respDoc["seq"] = request["seq"];
+    respDoc["t"] = request["t"];
+  }
+  
+  String response;
+  serializeJson(respDoc, response);
+  client->text(response);
+}
+
 // Отправка текущей конфигурации клиенту
 void WebServerManager::sendCurrentConfig(AsyncWebSocketClient* client) {
+  // Общий для всех клиентов сериализованный снимок, без повторной сборки
+  client->text(_configSnapshot.get());
+  sendPositions(client);
+}
+
+// Отправка текущих позиций (меняются при каждом движении, поэтому не входят в снимок)
+void WebServerManager::sendPositions(AsyncWebSocketClient* client) {
   JsonDocument doc;
-  
-  doc["servos"] = JsonArray();
-  JsonArray servos = doc["servos"].to<JsonArray>();
+  doc["command"] = "positions";
+  JsonArray positions = doc["positions"].to<JsonArray>();
   
   for (uint8_t i = 0; i < _servoController->getServoCount(); i++) {
-    ServoConfig config = _servoController->getServoConfig(i);
-    JsonObject servo = servos.add<JsonObject>();
-    servo["index"] = i;
-    servo["name"] = config.name;
-    servo["minPulse"] = config.minPulse;
-    servo["maxPulse"] = config.maxPulse;
-    servo["centerOffset"] = config.centerOffset;
-    servo["currentPos"] = config.currentPos;
+    positions.add(_servoController->getCurrentPosition(i));
+  }
+  
+  String response;
+  serializeJson(doc, response);
+  client->text(response);
+}
+
+// GET /api/config: снимок конфигурации с поддержкой If-None-Match
+void WebServerManager::handleGetConfig(AsyncWebServerRequest* request) {
+  AsyncWebSocketSharedBuffer snapshot = _configSnapshot.get();
+  const String& etag = _configSnapshot.getEtag();
+  
+  if (request->hasHeader("If-None-Match") &&
+      request->getHeader("If-None-Match")->value() == etag) {
+    AsyncWebServerResponse* response = request->beginResponse(304);
+    response->addHeader("ETag", etag);
+    request->send(response);
+    return;
+  }
+  
+  // Ответ читает из общего снимка; буфер живет, пока идет отправка
+  AsyncWebServerResponse* response = request->beginResponse("application/json", snapshot->size(),
+    [snapshot](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+      size_t n = snapshot->size() - index;
+      if (n > maxLen) n = maxLen;
+      memcpy(buffer, snapshot->data() + index, n);
+      return n;
+    });
+  response->addHeader("ETag", etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+// Прием тела PUT /api/config по частям в один буфер ограниченного размера
+void WebServerManager::handlePutConfigBody(AsyncWebServerRequest* request, uint8_t* data,
+                                           size_t len, size_t index, size_t total) {
+  if (total > CONFIG_MAX_BODY) {
+    return;
   }
   
-  doc["frequency"] = _servoController->getPWMFrequency();
+  if (index == 0) {
+    // Буфер освобождается веб-сервером вместе с запросом
+    request->_tempObject = malloc(total + 1);
+  }
+  
+  if (request->_tempObject && index + len <= total) {
+    memcpy((uint8_t*)request->_tempObject + index, data, len);
+    if (index + len == total) {
+      ((char*)request->_tempObject)[total] = 0;
+    }
+  }
+}
+
+// PUT /api/config: применение всей конфигурации одной записью в память
+void WebServerManager::handlePutConfig(AsyncWebServerRequest* request) {
+  if (request->contentLength() > CONFIG_MAX_BODY) {
+    request->send(413, "application/json", "{\"status\":\"error\",\"error\":\"too large\"}");
+    return;
+  }
+  if (!request->_tempObject) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"error\":\"empty body\"}");
+    return;
+  }
+  
+  // Разбор на месте: строки ссылаются на буфер запроса без копирования
+  JsonDocument doc;
+  DeserializationError error = deserializeJson(doc, (char*)request->_tempObject);
+  if (error) {
+    flightRecorder.record(FR_EVENT_FAULT, SRC_HTTP, FAULT_JSON_PARSE, error.code());
+    request->send(400, "application/json", "{\"status\":\"error\",\"error\":\"bad json\"}");
+    return;
+  }
+  
+  flightRecorder.record(FR_EVENT_COMMAND, SRC_HTTP, CMD_PUT_CONFIG);
+  
+  // Применяем изменения без промежуточных записей в память
+  for (JsonObject servo : doc["servos"].as<JsonArray>()) {
+    int servoIndex = servo["index"] | -1;
+    if (servoIndex < 0 || servoIndex >= _servoController->getServoCount()) {
+      continue;
+    }
+    
+    ServoConfig* config = &_servoController->getAllServoConfigs()[servoIndex];
+    _servoController->calibrateServo(servoIndex,
+                                     servo["minPulse"] | config->minPulse,
+                                     servo["maxPulse"] | config->maxPulse,
+                                     servo["centerOffset"] | config->centerOffset,
+                                     servo["name"].is<const char*>() ? String(servo["name"].as<const char*>())
+                                                                     : config->name,
+                                     false);
+    if (servo["loadClass"].is<int>()) {
+      _servoController->setLoadClass(servoIndex, servo["loadClass"].as<int>(), false);
+    }
+  }
+  
+  if (doc["frequency"].is<int>()) {
+    _servoController->setPWMFrequency(doc["frequency"].as<int>(), false);
+  }
+  if (doc["currentBudget"].is<int>()) {
+    int budget = doc["currentBudget"];
+    _motionScheduler->setCurrentBudget(constrain(budget, 0, 65535));
+  }
+  
+  // Одна пакетная запись всех настроек
+  _servoController->saveSettings();
+  
+  _configSnapshot.get();
+  AsyncWebServerResponse* response = request->beginResponse(200, "application/json",
+                                                            "{\"status\":\"ok\"}");
+  response->addHeader("ETag", _configSnapshot.getEtag());
+  request->send(response);
+}
+
+// Отправка телеметрии клиенту (nullptr - всем клиентам)
+void WebServerManager::sendTelemetry(AsyncWebSocketClient* client) {
+  JsonDocument doc;
+  doc["command"] = "telemetry";
+  doc["currentBudget"] = _motionScheduler->getCurrentBudget();
+  doc["estimatedCurrent"] = (int)_motionScheduler->getEstimatedCurrent();
+  doc["peakCurrent"] = (int)_motionScheduler->getPeakCurrent();
+  doc["moving"] = _motionScheduler->isMoving();
+  
+  // Задержки этапов прохождения команды, мкс
+  uint32_t p50, p99;
+  JsonObject latency = doc["latency"].to<JsonObject>();
+  _latencyTracer.getStats(LATENCY_STAGE_PARSE, p50, p99);
+  latency["parseP50"] = p50;
+  latency["parseP99"] = p99;
+  _latencyTracer.getStats(LATENCY_STAGE_QUEUE, p50, p99);
+  latency["queueP50"] = p50;
+  latency["queueP99"] = p99;
+  _latencyTracer.getStats(LATENCY_STAGE_I2C, p50, p99);
+  latency["i2cP50"] = p50;
+  latency["i2cP99"] = p99;
+  _latencyTracer.getStats(LATENCY_STAGE_TOTAL, p50, p99);
+  latency["totalP50"] = p50;
+  latency["totalP99"] = p99;
+  latency["samples"] = _latencyTracer.getSampleCount();
+  latency["sloUs"] = LATENCY_SLO_US;
+  latency["sloViolations"] = _latencyTracer.getSloViolations();
+  latency["traceTimeouts"] = _latencyTracer.getTraceTimeouts();
+  
+  // Воспроизведение потоковой траектории
+  TrajectoryStats traj = _trajectoryPlayer->getStats();
+  JsonObject trajectory = doc["trajectory"].to<JsonObject>();
+  trajectory["active"] = _trajectoryPlayer->isActive();
+  trajectory["buffered"] = traj.buffered;
+  trajectory["playoutDelayMs"] = traj.playoutDelayMs;
+  trajectory["jitterMs"] = traj.jitterMs;
+  trajectory["frames"] = traj.frames;
+  trajectory["late"] = traj.late;
+  trajectory["overflows"] = traj.overflows;
+  trajectory["underruns"] = traj.underruns;
+  
+  // Канал управления по UDP
+  UdpControlStats udpStats = _udpControl->getStats();
+  JsonObject udp = doc["udp"].to<JsonObject>();
+  udp["listening"] = _udpControl->isListening();
+  udp["received"] = udpStats.received;
+  udp["accepted"] = udpStats.accepted;
+  udp["lost"] = udpStats.lost;
+  udp["reordered"] = udpStats.reordered;
+  udp["stale"] = udpStats.stale;
+  udp["authFailed"] = udpStats.authFailed;
+  udp["malformed"] = udpStats.malformed;
+  udp["restarts"] = udpStats.restarts;
+  udp["active"] = _udpControl->isActive();
+  
+  // Режим и состояние радио
+  JsonObject radio = doc["radio"].to<JsonObject>();
+  radio["calibrationMode"] = _calibrationMode;
+  radio["state"] = RadioPowerManager::stateName(_radio.getState());
+  radio["modeSwitchUs"] = _lastModeSwitchUs;
+  radio["transitionUs"] = _radio.getLastTransitionUs();
+  JsonObject residency = radio["residencyMs"].to<JsonObject>();
+  for (uint8_t i = 0; i < RADIO_STATE_COUNT; i++) {
+    residency[RadioPowerManager::stateName((RadioState)i)] = _radio.getResidencyMs((RadioState)i);
+  }
   
   String response;
   serializeJson(doc, response);
   
-  client->text(response);
+  if (client) {
+    client->text(response);
+  } else {
+    _ws.textAll(response);
+  }
 }
 
 // Сохранение режима в энергонезависимую память
 void WebServerManager::saveMode(bool calibrationMode) {
   _preferences.begin("web-config", false);
   _preferences.putBool("cal_mode", calibrationMode);
+  _preferences.putBool("ap_mode", _apMode);
   _preferences.end();
 }
 
@@ -345,6 +745,12 @@ void WebServerManager::saveMode(bool calibrationMode) {
 bool WebServerManager::loadMode() {
   _preferences.begin("web-config", true);
   bool mode = _preferences.getBool("cal_mode", false);
+  _apMode = _preferences.getBool("ap_mode", _apMode);
+  _workingRadioState = (RadioState)_preferences.getUChar("radio_idle", RADIO_MODEM_SLEEP);
   _preferences.end();
+  
+  if (_workingRadioState == RADIO_FULL_POWER) {
+    _workingRadioState = RADIO_MODEM_SLEEP;
+  }
   return mode;
 }
\ No newline at end of file
@@ -9,28 +9,55 @@
 #include <ArduinoJson.h>
 #include <Preferences.h>
 #include "ServoController.h"
+#include "MotionScheduler.h"
+#include "LatencyTracer.h"
+#include "ConfigSnapshot.h"
+#include "RadioPowerManager.h"
+#include "WiFiRadioLink.h"
+#include "TrajectoryPlayer.h"
+#include "UdpControlServer.h"
+
+// Период рассылки телеметрии, мс
+#define TELEMETRY_INTERVAL_MS 250
+// Максимальный размер тела PUT /api/config, байт
+#define CONFIG_MAX_BODY 4096
 
 class WebServerManager {
 public:
-  // Конструктор получает ссылку на контроллер сервоприводов
-  WebServerManager(ServoController* servoController);
+  // Конструктор получает ссылки на контроллер сервоприводов, планировщик,
+  // воспроизведение потоковой траектории и канал управления по UDP
+  WebServerManager(ServoController* servoController, MotionScheduler* motionScheduler,
+                   TrajectoryPlayer* trajectoryPlayer, UdpControlServer* udpControl);
   
   // Инициализация
   bool begin();
   
   // Управление режимами
-  bool startCalibrationMode(const char* ssid = "AlashElectronics", 
-                          const char* password = "28071917", 
-                          bool apMode = false);
+  // Без параметров - с сохраненным режимом сети (AP/STA не меняется)
+  bool startCalibrationMode();
+  bool startCalibrationMode(bool apMode);
   void stopCalibrationMode();
   bool isCalibrationMode() const;
   
+  // Режим сети: точка доступа (true) или подключение станции (false).
+  // Сохраняется в память; активная связь перезапускается в новом режиме
+  void setNetworkMode(bool apMode);
+  bool isApMode() const;
+  
+  // Состояние радио в рабочем режиме (RADIO_OFF или RADIO_MODEM_SLEEP)
+  void setWorkingRadioState(RadioState state);
+  const RadioPowerManager& getRadio() const;
+  uint32_t getLastModeSwitchUs() const;
+  
   // Обработка периодических задач
   void update();
   
 private:
   // Внутренние переменные
   ServoController* _servoController;
+  MotionScheduler* _motionScheduler;
+  TrajectoryPlayer* _trajectoryPlayer;
+  UdpControlServer* _udpControl;
   AsyncWebServer _server;
   AsyncWebSocket _ws;
   Preferences _preferences;
@@ -38,14 +65,35 @@ private:
   bool _apMode;
   String _ssid, _password;
   AsyncWebSocketClient* _wsClient;
+  unsigned long _lastTelemetry;
+  LatencyTracer _latencyTracer;
+  
+  // Кэш сериализованной конфигурации (используется из задачи AsyncTCP)
+  ConfigSnapshot _configSnapshot;
+  
+  // Управление радио и режимами
+  WiFiRadioLink _radioLink;
+  RadioPowerManager _radio;
+  RadioState _workingRadioState;
+  bool _serverStarted;
+  uint32_t _lastModeSwitchUs;
   
   // Настройка веб-сервера и обработчики
   void setupWebServer();
+  void applyRadioState(RadioState state);
   static void onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, 
                              AwsEventType type, void* arg, uint8_t* data, size_t len);
   void handleWebSocketMessage(AsyncWebSocketClient* client, void* arg, 
-                            uint8_t* data, size_t len);
+                            uint8_t* data, size_t len, uint32_t rxUs);
+  void sendResponse(AsyncWebSocketClient* client, JsonDocument& respDoc,
+                    const JsonDocument& request);
   void sendCurrentConfig(AsyncWebSocketClient* client);
+  void sendPositions(AsyncWebSocketClient* client);
+  void handleGetConfig(AsyncWebServerRequest* request);
+  void handlePutConfigBody(AsyncWebServerRequest* request, uint8_t* data,
+                           size_t len, size_t index, size_t total);
+  void handlePutConfig(AsyncWebServerRequest* request);
+  void sendTelemetry(AsyncWebSocketClient* client);
   void saveMode(bool calibrationMode);
   bool loadMode();
   
@@ -0,0 +1,51 @@
+#include "WiFiRadioLink.h"
+
+// Запуск точки доступа
+void WiFiRadioLink::startAccessPoint(const String& ssid, const String& password) {
+  WiFi.mode(WIFI_AP);
+  WiFi.softAP(ssid.c_str(), password.c_str());
+}
+
+// Подключение к существующей сети; повторные попытки выполняет стек WiFi
+void WiFiRadioLink::startStation(const String& ssid, const String& password) {
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(true);
+  WiFi.begin(ssid.c_str(), password.c_str());
+}
+
+// Выключение WiFi
+void WiFiRadioLink::stop() {
+  WiFi.disconnect(true);
+  WiFi.mode(WIFI_OFF);
+}
+
+// Энергосбережение. Точка доступа не поддерживает modem sleep,
+// поэтому для нее снижается мощность передатчика.
+void WiFiRadioLink::setPowerSave(bool apMode, bool enabled) {
+  if (enabled) {
+    if (apMode) {
+      WiFi.setTxPower(WIFI_POWER_2dBm);
+    } else {
+      WiFi.setSleep(WIFI_PS_MAX_MODEM);
+    }
+  } else {
+    WiFi.setSleep(WIFI_PS_NONE);
+    WiFi.setTxPower(WIFI_POWER_19_5dBm);
+  }
+}
+
+// Станция подключена
+bool WiFiRadioLink::isConnected() const {
+  return WiFi.status() == WL_CONNECTED;
+}
+
+// Код состояния
+int WiFiRadioLink::status() const {
+  return WiFi.status();
+}
+
+// IPv4-адрес
+uint32_t WiFiRadioLink::localAddress(bool apMode) const {
+  IPAddress ip = apMode ? WiFi.softAPIP() : WiFi.localIP();
+  return ip[0] | (ip[1] << 8) | (ip[2] << 16) | ((uint32_t)ip[3] << 24);
+}
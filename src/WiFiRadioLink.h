@@ -0,0 +1,20 @@
+#ifndef WIFI_RADIO_LINK_H
+#define WIFI_RADIO_LINK_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "RadioPowerManager.h"
+
+// Управление радиомодулем ESP32 через WiFi
+class WiFiRadioLink : public RadioLink {
+public:
+  void startAccessPoint(const String& ssid, const String& password) override;
+  void startStation(const String& ssid, const String& password) override;
+  void stop() override;
+  void setPowerSave(bool apMode, bool enabled) override;
+  bool isConnected() const override;
+  int status() const override;
+  uint32_t localAddress(bool apMode) const override;
+};
+
+#endif // WIFI_RADIO_LINK_H
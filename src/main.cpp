@@ -1,6 +1,12 @@
 #include <Arduino.h>
 #include "ServoController.h"
+#include "MotionScheduler.h"
+#include "TrajectoryPlayer.h"
+#include "UdpControlServer.h"
 #include "WebServerManager.h"
+#include "FlightRecorder.h"
+#include "Logger.h"
+#include "RobotModel.h"
 
 // Пины I2C и адрес PCA9685
 #define I2C_SDA 21
@@ -9,7 +15,11 @@
 
 // Объекты для управления
 ServoController servoController(I2C_SDA, I2C_SCL, PCA9685_ADDR);
-WebServerManager webServerManager(&servoController);
+MotionScheduler motionScheduler(&servoController);
+TrajectoryPlayer trajectoryPlayer(&motionScheduler);
+UdpControlServer udpControl(&servoController, &motionScheduler);
+WebServerManager webServerManager(&servoController, &motionScheduler, &trajectoryPlayer,
+                                  &udpControl);
 
 // Буфер для команд Serial
 String serialCommand = "";
@@ -19,15 +29,25 @@ bool commandComplete = false;
 void processSerialCommand() {
   serialCommand.trim();
   
-  if (serialCommand.equals("calibration")) {
+  if (serialCommand.equals("calibration") || serialCommand.equals("calibration ap") ||
+      serialCommand.equals("calibration sta")) {
+    flightRecorder.record(FR_EVENT_COMMAND, SRC_SERIAL, CMD_CALIBRATION_MODE);
     Serial.println("Включение режима калибровки...");
-    if (webServerManager.startCalibrationMode()) {
-      Serial.println("Режим калибровки активирован");
+    bool started;
+    if (serialCommand.equals("calibration")) {
+      started = webServerManager.startCalibrationMode();
+    } else {
+      started = webServerManager.startCalibrationMode(serialCommand.endsWith(" ap"));
+    }
+    if (started) {
+      Serial.printf("Режим калибровки активирован (%s)\n",
+                    webServerManager.isApMode() ? "точка доступа" : "подключение к сети");
     } else {
       Serial.println("Ошибка при запуске режима калибровки");
     }
   }
   else if (serialCommand.equals("working")) {
+    flightRecorder.record(FR_EVENT_COMMAND, SRC_SERIAL, CMD_WORKING_MODE);
     Serial.println("Переключение в рабочий режим...");
     if (webServerManager.isCalibrationMode()) {
       webServerManager.stopCalibrationMode();
@@ -49,11 +69,94 @@ void processSerialCommand() {
     } else {
       Serial.println("Текущий режим: РАБОЧИЙ");
     }
+    Serial.printf("Робот: %s, ног: %u\n", ActiveRobotDescription::name, ActiveRobot::legCount);
+    Serial.printf("Радио: %s, последнее переключение режима: %u мкс\n",
+                  RadioPowerManager::stateName(webServerManager.getRadio().getState()),
+                  webServerManager.getLastModeSwitchUs());
+  }
+  else if (serialCommand.equals("radio")) {
+    const RadioPowerManager& radio = webServerManager.getRadio();
+    Serial.printf("Радио: %s, последний переход: %u мкс\n",
+                  RadioPowerManager::stateName(radio.getState()), radio.getLastTransitionUs());
+    for (uint8_t i = 0; i < RADIO_STATE_COUNT; i++) {
+      Serial.printf("  %-6s %u мс\n", RadioPowerManager::stateName((RadioState)i),
+                    radio.getResidencyMs((RadioState)i));
+    }
+  }
+  else if (serialCommand.equals("radio off")) {
+    webServerManager.setWorkingRadioState(RADIO_OFF);
+    Serial.println("В рабочем режиме WiFi будет выключен");
+  }
+  else if (serialCommand.equals("radio sleep")) {
+    webServerManager.setWorkingRadioState(RADIO_MODEM_SLEEP);
+    Serial.println("В рабочем режиме WiFi будет в режиме энергосбережения");
   }
   else if (serialCommand.equals("save")) {
+    flightRecorder.record(FR_EVENT_COMMAND, SRC_SERIAL, CMD_SAVE_SETTINGS);
     Serial.println("Сохранение всех настроек...");
     servoController.saveSettings();
   }
+  else if (serialCommand.equals("flightlog")) {
+    uint32_t minCycles, maxCycles, avgCycles;
+    Serial.printf("Бортовой журнал: %u записей всего, емкость %u\n",
+                  flightRecorder.getTotalRecords(), flightRecorder.getCapacity());
+    if (FlightRecorder::measureOverhead(64, minCycles, maxCycles, avgCycles)) {
+      Serial.printf("Стоимость записи (тактов): мин %u, сред %u, макс %u\n",
+                    minCycles, avgCycles, maxCycles);
+    } else {
+      Serial.println("Недостаточно памяти для замера стоимости записи");
+    }
+  }
+  else if (serialCommand.equals("logbench")) {
+    // Сравнение стоимости вызова: запись в кольцо и прямой вывод в Serial
+    uint32_t deferredMin, deferredMax, deferredAvg;
+    uint32_t directMin, directMax, directAvg;
+    logger.measureOverhead(32, false, deferredMin, deferredMax, deferredAvg);
+    logger.measureOverhead(32, true, directMin, directMax, directAvg);
+    Serial.printf("Отложенный журнал (тактов): мин %u, сред %u, макс %u\n",
+                  deferredMin, deferredAvg, deferredMax);
+    Serial.printf("Прямой Serial.printf (тактов): мин %u, сред %u, макс %u\n",
+                  directMin, directAvg, directMax);
+    Serial.printf("Журнал: выведено %u, отброшено %u\n",
+                  logger.getWritten(), logger.getDropped());
+  }
+  else if (serialCommand.equals("powersim")) {
+    // Симуляция перемещения всех сервоприводов в 0° и 180° с бюджетом и без
+    int angles[] = { 0, 180 };
+    for (int angle : angles) {
+      MotionStats limited = motionScheduler.simulateMoveAll(angle);
+      MotionStats unlimited = motionScheduler.simulateMoveAll(angle, true);
+      Serial.printf("Все в %d°: бюджет %u мА -> пик %.0f мА, %u мс; без ограничения -> пик %.0f мА, %u мс\n",
+                    angle, motionScheduler.getCurrentBudget(),
+                    limited.peakCurrent, limited.completionMs,
+                    unlimited.peakCurrent, unlimited.completionMs);
+    }
+  }
+  else if (serialCommand.startsWith("stand ")) {
+    float height = serialCommand.substring(6).toFloat();
+    FootTarget feet[ActiveRobot::legCount];
+    ActiveRobot::standingFeet(height, feet);
+    flightRecorder.record(FR_EVENT_COMMAND, SRC_SERIAL, CMD_SET_FEET);
+    if (ActiveRobot::moveFeet(motionScheduler, feet)) {
+      Serial.printf("Стойка на высоте %d мм\n", (int)height);
+    } else {
+      Serial.println("Высота недостижима для ног робота");
+    }
+  }
+  else if (serialCommand.startsWith("udptoken ")) {
+    uint32_t token = strtoul(serialCommand.substring(9).c_str(), nullptr, 10);
+    udpControl.setToken(token);
+    Serial.println(token ? "Токен UDP установлен" : "Проверка токена UDP отключена");
+  }
+  else if (serialCommand.equals("udp")) {
+    UdpControlStats stats = udpControl.getStats();
+    Serial.printf("UDP: порт %u, %s\n", UDP_CONTROL_PORT,
+                  udpControl.isListening() ? "прием включен" : "ожидание WiFi");
+    Serial.printf("  принято %u, применено %u, потеряно %u, вне порядка %u, устаревших %u, "
+                  "ошибок токена %u, ошибок формата %u, перезапусков отправителя %u\n",
+                  stats.received, stats.accepted, stats.lost, stats.reordered, stats.stale,
+                  stats.authFailed, stats.malformed, stats.restarts);
+  }
   else if (serialCommand.equals("reset")) {
     Serial.println("Перезагрузка устройства...");
     ESP.restart();
@@ -61,9 +164,20 @@ void processSerialCommand() {
   else if (serialCommand.equals("help") || serialCommand.equals("?")) {
     Serial.println("\n--- Доступные команды ---");
     Serial.println("calibration - Включить режим калибровки (WiFi и веб-интерфейс)");
-    Serial.println("working     - Переключиться в рабочий режим (выключить WiFi)");
+    Serial.println("calibration ap  - То же, WiFi в режиме точки доступа (сохраняется)");
+    Serial.println("calibration sta - То же, подключение к существующей сети (сохраняется)");
+    Serial.println("working     - Переключиться в рабочий режим (WiFi в энергосбережение)");
     Serial.println("status      - Показать текущий статус");
+    Serial.println("radio       - Состояние радио и время в каждом состоянии");
+    Serial.println("radio off   - Выключать WiFi в рабочем режиме");
+    Serial.println("radio sleep - Держать WiFi в энергосбережении в рабочем режиме");
     Serial.println("save        - Сохранить все настройки в память");
+    Serial.println("flightlog   - Статистика бортового журнала и стоимость записи");
+    Serial.println("logbench    - Стоимость отложенного журнала и прямого вывода");
+    Serial.println("powersim    - Симуляция пикового тока и времени группового перемещения");
+    Serial.println("stand H     - Стойка с высотой H мм (обратная кинематика)");
+    Serial.println("udp         - Счетчики канала управления по UDP");
+    Serial.println("udptoken N  - Установить токен UDP (0 - без проверки)");
     Serial.println("reset       - Перезагрузить устройство");
     Serial.println("help или ?  - Показать эту справку");
   }
@@ -102,6 +216,9 @@ void setup() {
   // Небольшая задержка для стабилизации последовательного порта
   delay(500);
   
+  // Задача вывода отложенного журнала
+  logger.begin();
+  
   Serial.println("\n-----------------------------------");
   Serial.println("Система управления сервоприводами");
   Serial.println("-----------------------------------");
@@ -110,6 +227,13 @@ void setup() {
   servoController.begin(50);
   Serial.println("Контроллер сервоприводов инициализирован");
   
+  // Инициализация планировщика перемещений с пределами суставов робота
+  motionScheduler.begin();
+  ActiveRobot::applyLimits(motionScheduler);
+  
+  // Канал управления по UDP (прием начнется после запуска WiFi)
+  udpControl.begin();
+  
   // Инициализация веб-сервера
   if (webServerManager.begin()) {
     if (webServerManager.isCalibrationMode()) {
@@ -140,6 +264,17 @@ void loop() {
     processSerialCommand();
   }
   
+  // Команды, принятые по UDP
+  udpControl.update();
+  
+  // Воспроизведение потоковой траектории с фиксированным периодом
+  trajectoryPlayer.update();
+  
+  // Плавное выполнение перемещений в пределах бюджета тока.
+  // Пределы суставов не действуют в режиме калибровки
+  motionScheduler.setLimitsEnabled(!webServerManager.isCalibrationMode());
+  motionScheduler.update();
+  
   // Обслуживание веб-сервера в режиме калибровки
   webServerManager.update();
   
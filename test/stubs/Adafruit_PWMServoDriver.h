@@ -0,0 +1,26 @@
+#ifndef ADAFRUIT_PWM_SERVO_DRIVER_STUB_H
+#define ADAFRUIT_PWM_SERVO_DRIVER_STUB_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// PCA9685 для тестов на хосте: запоминает последние импульсы и число записей,
+// запись по I2C длится writeUs
+class Adafruit_PWMServoDriver {
+public:
+  uint16_t pulses[16] = {};
+  uint32_t writes = 0;
+  static inline uint32_t writeUs = 0;
+
+  Adafruit_PWMServoDriver(uint8_t = 0x40, TwoWire& = Wire) {}
+  bool begin() { return true; }
+  void setPWMFreq(float) {}
+  uint8_t setPWM(uint8_t channel, uint16_t, uint16_t off) {
+    if (channel < 16) pulses[channel] = off;
+    writes++;
+    stubAdvanceMicros(writeUs);
+    return 0;
+  }
+};
+
+#endif // ADAFRUIT_PWM_SERVO_DRIVER_STUB_H
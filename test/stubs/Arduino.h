@@ -0,0 +1,149 @@
+#ifndef ARDUINO_STUB_H
+#define ARDUINO_STUB_H
+
+// Минимальная замена ядра Arduino для тестов на хосте (env:native).
+// Время управляется тестом: micros()/millis() идут только через
+// stubAdvanceMicros() и delay().
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define PI 3.1415926535897932384626433832795
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define HEX 16
+#define IRAM_ATTR
+
+// Время
+inline uint32_t& stubMicros() {
+  static uint32_t now = 0;
+  return now;
+}
+inline void stubAdvanceMicros(uint32_t us) { stubMicros() += us; }
+inline uint32_t micros() { return stubMicros(); }
+inline uint32_t millis() { return stubMicros() / 1000; }
+inline void delay(uint32_t ms) { stubAdvanceMicros(ms * 1000); }
+
+inline long random(long howbig) { return howbig > 0 ? rand() % howbig : 0; }
+inline uint32_t esp_random() { return (uint32_t)rand(); }
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+template <class T, class L, class H>
+inline T constrain(T x, L low, H high) {
+  return x < (T)low ? (T)low : (x > (T)high ? (T)high : x);
+}
+
+// Строка Arduino поверх std::string
+class String : public std::string {
+public:
+  String() {}
+  String(const char* s) : std::string(s ? s : "") {}
+  String(const std::string& s) : std::string(s) {}
+  String(int value) : std::string(std::to_string(value)) {}
+  String(unsigned int value) : std::string(std::to_string(value)) {}
+  String(long value) : std::string(std::to_string(value)) {}
+  String(unsigned long value) : std::string(std::to_string(value)) {}
+  String(unsigned int value, int base) : String((unsigned long)value, base) {}
+  String(unsigned long value, int base) {
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), base == HEX ? "%lx" : "%lu", value);
+    assign(buffer);
+  }
+  bool equals(const char* other) const { return *this == other; }
+  void toCharArray(char* buffer, unsigned int size) const {
+    if (size == 0) return;
+    size_t n = std::min((size_t)size - 1, length());
+    memcpy(buffer, data(), n);
+    buffer[n] = 0;
+  }
+  void trim() {
+    size_t first = find_first_not_of(" \t\r\n");
+    size_t last = find_last_not_of(" \t\r\n");
+    *this = first == npos ? String() : String(substr(first, last - first + 1));
+  }
+};
+inline String operator+(const String& a, const String& b) {
+  return String(static_cast<const std::string&>(a) + static_cast<const std::string&>(b));
+}
+inline String operator+(const char* a, const String& b) { return String(a) + b; }
+inline String operator+(const String& a, const char* b) { return a + String(b); }
+
+// Последовательный порт: вывод накапливается для проверок в тестах
+class SerialStub {
+public:
+  std::string output;
+  size_t lines = 0;
+
+  void begin(unsigned long) {}
+  int printf(const char* format, ...) {
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    append(buffer);
+    return n;
+  }
+  template <class T> void print(const T& value) { append(toText(value).c_str()); }
+  template <class T> void println(const T& value) { append((toText(value) + "\n").c_str()); }
+  void println() { append("\n"); }
+  int available() { return 0; }
+  int read() { return -1; }
+  void clear() { output.clear(); lines = 0; }
+
+private:
+  void append(const char* text) {
+    output += text;
+    lines += std::count(text, text + strlen(text), '\n');
+  }
+  static std::string toText(const char* value) { return value; }
+  static std::string toText(const std::string& value) { return value; }
+  template <class T> static std::string toText(const T& value) { return std::to_string(value); }
+};
+inline SerialStub Serial;
+
+// ESP: счетчик тактов заменен наносекундами монотонных часов хоста
+class EspStub {
+public:
+  uint32_t getCycleCount() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+  void restart() {}
+};
+inline EspStub ESP;
+
+// Критические секции FreeRTOS
+struct portMUX_TYPE {
+  std::recursive_mutex mutex;
+};
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) (mux)->mutex.lock()
+#define portEXIT_CRITICAL(mux) (mux)->mutex.unlock()
+
+// Задачи FreeRTOS: задача не запускается, тест вызывает ее работу сам
+typedef void* TaskHandle_t;
+#define tskIDLE_PRIORITY 0
+#define pdPASS 1
+#define pdMS_TO_TICKS(ms) (ms)
+inline int xTaskCreate(void (*)(void*), const char*, uint32_t, void*, int, TaskHandle_t* handle) {
+  static int dummy;
+  if (handle) *handle = &dummy;
+  return pdPASS;
+}
+inline void vTaskDelay(uint32_t) {}
+
+#endif // ARDUINO_STUB_H
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef PREFERENCES_STUB_H
+#define PREFERENCES_STUB_H
+
+#include <Arduino.h>
+#include <map>
+
+// Энергонезависимая память для тестов на хосте: общее хранилище в ОЗУ
+// на все время работы теста, по пространствам имен
+class Preferences {
+public:
+  bool begin(const char* name, bool = false) { _space = name; return true; }
+  void end() {}
+
+  size_t putBool(const char* key, bool value) { return put(key, value ? "1" : "0"); }
+  size_t putInt(const char* key, int32_t value) { return put(key, std::to_string(value)); }
+  size_t putUInt(const char* key, uint32_t value) { return put(key, std::to_string(value)); }
+  size_t putUChar(const char* key, uint8_t value) { return put(key, std::to_string(value)); }
+  size_t putString(const char* key, const String& value) { return put(key, value); }
+
+  bool getBool(const char* key, bool def = false) { return has(key) ? get(key) == "1" : def; }
+  int32_t getInt(const char* key, int32_t def = 0) { return has(key) ? std::stol(get(key)) : def; }
+  uint32_t getUInt(const char* key, uint32_t def = 0) { return has(key) ? std::stoul(get(key)) : def; }
+  uint8_t getUChar(const char* key, uint8_t def = 0) { return has(key) ? std::stoul(get(key)) : def; }
+  String getString(const char* key, const String& def = String()) { return has(key) ? String(get(key)) : def; }
+
+  // Очистка хранилища между тестами
+  static void clearAll() { storage().clear(); }
+
+private:
+  std::string _space;
+
+  static std::map<std::string, std::string>& storage() {
+    static std::map<std::string, std::string> values;
+    return values;
+  }
+  std::string path(const char* key) const { return _space + "/" + key; }
+  bool has(const char* key) const { return storage().count(path(key)) > 0; }
+  std::string get(const char* key) const { return storage()[path(key)]; }
+  size_t put(const char* key, const std::string& value) {
+    storage()[path(key)] = value;
+    return value.size();
+  }
+};
+
+#endif // PREFERENCES_STUB_H
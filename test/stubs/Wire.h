@@ -0,0 +1,12 @@
+#ifndef WIRE_STUB_H
+#define WIRE_STUB_H
+
+// Шина I2C для тестов на хосте: обращения ничего не делают
+class TwoWire {
+public:
+  bool begin(int, int) { return true; }
+  void setClock(uint32_t) {}
+};
+inline TwoWire Wire;
+
+#endif // WIRE_STUB_H
@@ -0,0 +1,108 @@
+#include <unity.h>
+#include <string>
+#include "ConfigSnapshot.h"
+
+static ServoController* servos;
+static MotionScheduler* scheduler;
+static ConfigSnapshot* snapshot;
+
+void setUp() {
+  servos = new ServoController(21, 22);
+  servos->begin();
+  scheduler = new MotionScheduler(servos);
+  scheduler->begin();
+  snapshot = new ConfigSnapshot(servos, scheduler);
+  snapshot->begin(0xBEEF);
+}
+
+void tearDown() {
+  delete snapshot;
+  delete scheduler;
+  delete servos;
+}
+
+static std::string text(const JsonSharedBuffer& buffer) {
+  return std::string(buffer->begin(), buffer->end());
+}
+
+// После изменения снимок пересобран, ETag новый
+static void assertRebuilt(const JsonSharedBuffer& before, const String& etagBefore) {
+  JsonSharedBuffer after = snapshot->get();
+  TEST_ASSERT_TRUE(after != before);
+  TEST_ASSERT_FALSE(snapshot->getEtag() == etagBefore);
+}
+
+void test_repeated_fetch_reuses_buffer_and_etag() {
+  JsonSharedBuffer first = snapshot->get();
+  String etag = snapshot->getEtag();
+  TEST_ASSERT_EQUAL_STRING("\"beef-1\"", etag.c_str());
+
+  for (int i = 0; i < 5; i++) {
+    TEST_ASSERT_TRUE(snapshot->get() == first);
+    TEST_ASSERT_EQUAL_STRING(etag.c_str(), snapshot->getEtag().c_str());
+  }
+}
+
+void test_calibration_rebuilds_snapshot() {
+  JsonSharedBuffer before = snapshot->get();
+  String etag = snapshot->getEtag();
+
+  servos->calibrateServo(3, 160, 590, 5, "Колено");
+  assertRebuilt(before, etag);
+  TEST_ASSERT_TRUE(text(snapshot->get()).find("\"minPulse\":160") != std::string::npos);
+}
+
+void test_frequency_change_rebuilds_snapshot() {
+  JsonSharedBuffer before = snapshot->get();
+  String etag = snapshot->getEtag();
+
+  servos->setPWMFrequency(60);
+  assertRebuilt(before, etag);
+  TEST_ASSERT_TRUE(text(snapshot->get()).find("\"frequency\":60") != std::string::npos);
+}
+
+void test_budget_change_rebuilds_snapshot() {
+  JsonSharedBuffer before = snapshot->get();
+  String etag = snapshot->getEtag();
+
+  uint16_t budget = scheduler->getCurrentBudget() + 500;
+  scheduler->setCurrentBudget(budget);
+  assertRebuilt(before, etag);
+  std::string expected = "\"currentBudget\":" + std::to_string(budget);
+  TEST_ASSERT_TRUE(text(snapshot->get()).find(expected) != std::string::npos);
+}
+
+void test_unpersisted_changes_rebuild_snapshot() {
+  // Путь PUT /api/config: изменения без записи в память, затем saveSettings
+  JsonSharedBuffer before = snapshot->get();
+  String etag = snapshot->getEtag();
+  servos->calibrateServo(0, 170, 580, 0, "Плечо", false);
+  assertRebuilt(before, etag);
+
+  before = snapshot->get();
+  etag = snapshot->getEtag();
+  servos->setLoadClass(0, LOAD_CLASS_HEAVY, false);
+  assertRebuilt(before, etag);
+
+  before = snapshot->get();
+  etag = snapshot->getEtag();
+  servos->setPWMFrequency(55, false);
+  assertRebuilt(before, etag);
+
+  // Сама пакетная запись конфигурацию не меняет
+  before = snapshot->get();
+  etag = snapshot->getEtag();
+  servos->saveSettings();
+  TEST_ASSERT_TRUE(snapshot->get() == before);
+  TEST_ASSERT_EQUAL_STRING(etag.c_str(), snapshot->getEtag().c_str());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_repeated_fetch_reuses_buffer_and_etag);
+  RUN_TEST(test_calibration_rebuilds_snapshot);
+  RUN_TEST(test_frequency_change_rebuilds_snapshot);
+  RUN_TEST(test_budget_change_rebuilds_snapshot);
+  RUN_TEST(test_unpersisted_changes_rebuild_snapshot);
+  return UNITY_END();
+}
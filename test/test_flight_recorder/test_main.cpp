@@ -0,0 +1,126 @@
+#include <unity.h>
+#include <vector>
+#include "FlightRecorder.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Полная выгрузка фрагментами заданного размера
+static std::vector<uint8_t> dump(const FlightRecorder& recorder, const FlightLogSnapshot& snap,
+                                 size_t chunk) {
+  std::vector<uint8_t> out;
+  std::vector<uint8_t> buffer(chunk);
+  size_t n;
+  while ((n = recorder.read(snap, out.size(), buffer.data(), chunk)) > 0) {
+    out.insert(out.end(), buffer.begin(), buffer.begin() + n);
+  }
+  return out;
+}
+
+static FlightRecord recordAt(const std::vector<uint8_t>& data, size_t index) {
+  FlightRecord record;
+  memcpy(&record, data.data() + sizeof(FlightLogHeader) + index * sizeof(FlightRecord),
+         sizeof(record));
+  return record;
+}
+
+void test_dump_has_header_and_records() {
+  FlightRecorder* recorder = new FlightRecorder();
+  for (int16_t i = 0; i < 3; i++) {
+    stubAdvanceMicros(100);
+    recorder->record(FR_EVENT_COMMAND, SRC_WEBSOCKET, i, 1000 + i);
+  }
+
+  FlightLogSnapshot snap = recorder->snapshot();
+  std::vector<uint8_t> data = dump(*recorder, snap, 512);
+  TEST_ASSERT_EQUAL(recorder->dumpSize(snap), data.size());
+
+  FlightLogHeader header;
+  memcpy(&header, data.data(), sizeof(header));
+  TEST_ASSERT_EQUAL_MEMORY("QSFR", header.magic, 4);
+  TEST_ASSERT_EQUAL(FLIGHT_RECORDER_FORMAT_VERSION, header.version);
+  TEST_ASSERT_EQUAL(sizeof(FlightRecord), header.recordSize);
+  TEST_ASSERT_EQUAL(3, header.count);
+  TEST_ASSERT_EQUAL(3, header.total);
+
+  for (int16_t i = 0; i < 3; i++) {
+    FlightRecord record = recordAt(data, i);
+    TEST_ASSERT_EQUAL(FR_EVENT_COMMAND, record.type);
+    TEST_ASSERT_EQUAL(SRC_WEBSOCKET, record.arg);
+    TEST_ASSERT_EQUAL(i, record.value);
+    TEST_ASSERT_EQUAL(1000 + i, record.aux);
+  }
+  delete recorder;
+}
+
+void test_chunked_read_matches_single_read() {
+  FlightRecorder* recorder = new FlightRecorder();
+  for (int16_t i = 0; i < 100; i++) {
+    recorder->record(FR_EVENT_POSE, i % 16, i, i * 3);
+  }
+
+  FlightLogSnapshot snap = recorder->snapshot();
+  std::vector<uint8_t> whole = dump(*recorder, snap, recorder->dumpSize(snap));
+  const size_t chunks[] = { 1, 5, 7, 12, 64, 1460 };
+  for (size_t chunk : chunks) {
+    std::vector<uint8_t> parts = dump(*recorder, snap, chunk);
+    TEST_ASSERT_EQUAL(whole.size(), parts.size());
+    TEST_ASSERT_EQUAL_MEMORY(whole.data(), parts.data(), whole.size());
+  }
+  delete recorder;
+}
+
+void test_wraparound_keeps_latest_records_in_order() {
+  FlightRecorder* recorder = new FlightRecorder();
+  const uint32_t extra = 10;
+  for (uint32_t i = 0; i < FLIGHT_RECORDER_CAPACITY + extra; i++) {
+    recorder->record(FR_EVENT_MARKER, 0, (int16_t)i);
+  }
+
+  FlightLogSnapshot snap = recorder->snapshot();
+  TEST_ASSERT_EQUAL(FLIGHT_RECORDER_CAPACITY, snap.count);
+  TEST_ASSERT_EQUAL(extra, snap.first);
+
+  std::vector<uint8_t> data = dump(*recorder, snap, 256);
+  for (uint32_t i = 0; i < snap.count; i++) {
+    TEST_ASSERT_EQUAL((int16_t)(extra + i), recordAt(data, i).value);
+  }
+  delete recorder;
+}
+
+void test_read_past_end_returns_zero() {
+  FlightRecorder* recorder = new FlightRecorder();
+  recorder->record(FR_EVENT_MODE, SRC_NONE, 1);
+
+  FlightLogSnapshot snap = recorder->snapshot();
+  uint8_t buffer[64];
+  TEST_ASSERT_EQUAL(0, recorder->read(snap, recorder->dumpSize(snap), buffer, sizeof(buffer)));
+  delete recorder;
+}
+
+void test_measure_overhead_leaves_live_log_untouched() {
+  flightRecorder.record(FR_EVENT_MODE, SRC_NONE, 0);
+  uint32_t before = flightRecorder.getTotalRecords();
+
+  uint32_t minCycles, maxCycles, avgCycles;
+  TEST_ASSERT_TRUE(FlightRecorder::measureOverhead(1000, minCycles, maxCycles, avgCycles));
+  TEST_ASSERT_EQUAL(before, flightRecorder.getTotalRecords());
+  TEST_ASSERT_TRUE(minCycles <= avgCycles);
+  TEST_ASSERT_TRUE(avgCycles <= maxCycles);
+
+  // На хосте счетчик тактов заменен наносекундами
+  char message[96];
+  snprintf(message, sizeof(message), "record(): min %u ns, avg %u ns, max %u ns",
+           minCycles, avgCycles, maxCycles);
+  TEST_MESSAGE(message);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_dump_has_header_and_records);
+  RUN_TEST(test_chunked_read_matches_single_read);
+  RUN_TEST(test_wraparound_keeps_latest_records_in_order);
+  RUN_TEST(test_read_past_end_returns_zero);
+  RUN_TEST(test_measure_overhead_leaves_live_log_untouched);
+  return UNITY_END();
+}
\ No newline at end of file
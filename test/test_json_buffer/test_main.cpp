@@ -0,0 +1,64 @@
+#include <unity.h>
+#include <string>
+#include "JsonBuffer.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Документ в форме снимка конфигурации
+static void fillConfig(JsonDocument& doc, uint8_t servoCount) {
+  JsonArray servos = doc["servos"].to<JsonArray>();
+  for (uint8_t i = 0; i < servoCount; i++) {
+    JsonObject servo = servos.add<JsonObject>();
+    servo["index"] = i;
+    servo["name"] = "Серво";
+    servo["minPulse"] = 150;
+    servo["maxPulse"] = 600;
+  }
+  doc["frequency"] = 50;
+  doc["currentBudget"] = 5000;
+}
+
+static void assertMatchesSerializeJson(const JsonDocument& doc) {
+  std::string expected;
+  serializeJson(doc, expected);
+
+  JsonSharedBuffer buffer = serializeJsonBuffer(doc);
+  TEST_ASSERT_EQUAL(measureJson(doc), buffer->size());
+  TEST_ASSERT_EQUAL(expected.size(), buffer->size());
+  TEST_ASSERT_EQUAL_MEMORY(expected.data(), buffer->data(), expected.size());
+}
+
+void test_buffer_keeps_closing_brace() {
+  JsonDocument doc;
+  fillConfig(doc, 16);
+
+  JsonSharedBuffer buffer = serializeJsonBuffer(doc);
+  TEST_ASSERT_EQUAL('{', buffer->front());
+  TEST_ASSERT_EQUAL('}', buffer->back());
+}
+
+void test_buffer_matches_serialize_json() {
+  for (uint8_t count = 0; count <= 16; count++) {
+    JsonDocument doc;
+    fillConfig(doc, count);
+    assertMatchesSerializeJson(doc);
+  }
+}
+
+void test_buffer_of_single_value() {
+  JsonDocument doc;
+  doc["a"] = 1;
+  assertMatchesSerializeJson(doc);
+
+  JsonDocument empty;
+  assertMatchesSerializeJson(empty);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_buffer_keeps_closing_brace);
+  RUN_TEST(test_buffer_matches_serialize_json);
+  RUN_TEST(test_buffer_of_single_value);
+  return UNITY_END();
+}
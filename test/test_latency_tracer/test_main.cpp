@@ -0,0 +1,106 @@
+#include <unity.h>
+#include "LatencyTracer.h"
+
+void setUp() {
+  Adafruit_PWMServoDriver::writeUs = 0;
+}
+void tearDown() {}
+
+static const uint32_t PARSE_US = 200;
+static const uint32_t WRITE_US = 300;
+
+// Цикл loop: такт планировщика, затем завершение трассировок
+static void runLoop(MotionScheduler& scheduler, LatencyTracer& tracer,
+                    const ServoController& servos, uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    stubAdvanceMicros(1000);
+    scheduler.update();
+    tracer.update(&servos, &scheduler);
+  }
+}
+
+// Команда передана планировщику сейчас и отслеживается трассировщиком
+static uint32_t traceCommand(MotionScheduler& scheduler, LatencyTracer& tracer,
+                             uint8_t servoIndex, int angle) {
+  uint32_t dispatchUs = micros();
+  TEST_ASSERT_TRUE(scheduler.moveTo(servoIndex, angle));
+  tracer.begin(1, servoIndex, dispatchUs - PARSE_US, dispatchUs);
+  return dispatchUs;
+}
+
+void test_stages_split_queue_wait_and_i2c_write() {
+  ServoController servos(21, 22);
+  servos.begin();
+  MotionScheduler scheduler(&servos);
+  scheduler.begin();
+  LatencyTracer tracer;
+  Adafruit_PWMServoDriver::writeUs = WRITE_US;
+
+  // Команда приходит через 3 мс после начала периода такта
+  stubAdvanceMicros(3000);
+  uint32_t dispatchUs = traceCommand(scheduler, tracer, 0, 120);
+  runLoop(scheduler, tracer, servos, 20);
+
+  TEST_ASSERT_EQUAL(1, tracer.getSampleCount());
+  uint32_t pickupUs = scheduler.getLastPickupMicros(0);
+  TEST_ASSERT_TRUE(pickupUs - dispatchUs >= 1000);
+
+  uint32_t p50, p99;
+  tracer.getStats(LATENCY_STAGE_PARSE, p50, p99);
+  TEST_ASSERT_EQUAL(PARSE_US, p50);
+  tracer.getStats(LATENCY_STAGE_QUEUE, p50, p99);
+  TEST_ASSERT_EQUAL(pickupUs - dispatchUs, p50);
+  tracer.getStats(LATENCY_STAGE_I2C, p50, p99);
+  TEST_ASSERT_EQUAL(WRITE_US, p50);
+  tracer.getStats(LATENCY_STAGE_TOTAL, p50, p99);
+  TEST_ASSERT_EQUAL(PARSE_US + (pickupUs - dispatchUs) + WRITE_US, p50);
+  TEST_ASSERT_EQUAL(0, tracer.getTraceTimeouts());
+}
+
+void test_direct_write_before_pickup_does_not_complete_trace() {
+  ServoController servos(21, 22);
+  servos.begin();
+  MotionScheduler scheduler(&servos);
+  scheduler.begin();
+  LatencyTracer tracer;
+
+  stubAdvanceMicros(1000);
+  uint32_t dispatchUs = traceCommand(scheduler, tracer, 1, 150);
+
+  // Запись в обход планировщика до его такта
+  stubAdvanceMicros(500);
+  servos.setPosition(2, 60);
+  servos.setPosition(1, 100);
+  tracer.update(&servos, &scheduler);
+  TEST_ASSERT_EQUAL(0, tracer.getSampleCount());
+
+  runLoop(scheduler, tracer, servos, 20);
+  TEST_ASSERT_EQUAL(1, tracer.getSampleCount());
+
+  uint32_t p50, p99;
+  tracer.getStats(LATENCY_STAGE_QUEUE, p50, p99);
+  TEST_ASSERT_EQUAL(scheduler.getLastPickupMicros(1) - dispatchUs, p50);
+}
+
+void test_stopped_command_times_out() {
+  ServoController servos(21, 22);
+  servos.begin();
+  MotionScheduler scheduler(&servos);
+  scheduler.begin();
+  LatencyTracer tracer;
+
+  traceCommand(scheduler, tracer, 3, 10);
+  scheduler.stop();
+  runLoop(scheduler, tracer, servos, LATENCY_TRACE_TIMEOUT_US / 1000 + 10);
+
+  TEST_ASSERT_EQUAL(0, tracer.getSampleCount());
+  TEST_ASSERT_EQUAL(1, tracer.getTraceTimeouts());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_stages_split_queue_wait_and_i2c_write);
+  RUN_TEST(test_direct_write_before_pickup_does_not_complete_trace);
+  RUN_TEST(test_stopped_command_times_out);
+  return UNITY_END();
+}
@@ -0,0 +1,134 @@
+#include <unity.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <sstream>
+#include "Logger.h"
+
+void setUp() {
+  Serial.clear();
+}
+void tearDown() {}
+
+void test_log_defers_formatting_to_flush() {
+  Logger* log = new Logger();
+
+  TEST_ASSERT_TRUE(log->log(LOG_LEVEL_WARN, "client #%u from %s", 7u, "192.168.4.2"));
+  TEST_ASSERT_EQUAL(0, Serial.output.size());
+
+  log->flush();
+  TEST_ASSERT_TRUE(Serial.output.find(" W] client #7 from 192.168.4.2\n") != std::string::npos);
+  TEST_ASSERT_EQUAL(1, log->getWritten());
+  delete log;
+}
+
+void test_full_ring_drops_without_blocking() {
+  Logger* log = new Logger();
+  for (uint32_t i = 0; i < LOGGER_CAPACITY; i++) {
+    TEST_ASSERT_TRUE(log->log(LOG_LEVEL_INFO, "record %u", i));
+  }
+  TEST_ASSERT_FALSE(log->log(LOG_LEVEL_INFO, "record %u", 999u));
+  TEST_ASSERT_EQUAL(1, log->getDropped());
+
+  // После вывода место освобождается, порядок записей сохранен
+  log->flush();
+  TEST_ASSERT_EQUAL(LOGGER_CAPACITY, Serial.lines);
+  TEST_ASSERT_TRUE(Serial.output.find("record 0\n") < Serial.output.find("record 63\n"));
+  TEST_ASSERT_TRUE(log->log(LOG_LEVEL_INFO, "record %u", 64u));
+  delete log;
+}
+
+void test_concurrent_producers_deliver_each_record_once() {
+  const uint32_t producers = 4;
+  const uint32_t perProducer = 5000;
+  Logger* log = new Logger();
+  std::atomic<uint32_t> running(producers);
+
+  std::vector<std::thread> threads;
+  for (uint32_t p = 0; p < producers; p++) {
+    threads.emplace_back([log, p, &running]() {
+      for (uint32_t i = 0; i < perProducer; i++) {
+        // При заполненном кольце запись отбрасывается; здесь повторяем,
+        // чтобы проверить доставку каждой записи
+        while (!log->log(LOG_LEVEL_INFO, "producer %u seq %u", p, i)) {
+          std::this_thread::yield();
+        }
+      }
+      running--;
+    });
+  }
+
+  // Один потребитель, как задача вывода на устройстве
+  while (running > 0) {
+    log->flush();
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  log->flush();
+
+  TEST_ASSERT_EQUAL(producers * perProducer, log->getWritten());
+  TEST_ASSERT_EQUAL(producers * perProducer, Serial.lines);
+
+  // Записи каждого производителя выведены по порядку, без пропусков и повторов
+  int64_t last[producers];
+  for (uint32_t p = 0; p < producers; p++) {
+    last[p] = -1;
+  }
+  std::istringstream lines(Serial.output);
+  std::string line;
+  while (std::getline(lines, line)) {
+    unsigned producer, seq;
+    TEST_ASSERT_EQUAL(2, sscanf(line.c_str() + line.find("producer"), "producer %u seq %u",
+                                &producer, &seq));
+    TEST_ASSERT_TRUE(producer < producers);
+    TEST_ASSERT_EQUAL(last[producer] + 1, (int64_t)seq);
+    last[producer] = seq;
+  }
+  for (uint32_t p = 0; p < producers; p++) {
+    TEST_ASSERT_EQUAL(perProducer - 1, last[p]);
+  }
+
+  char message[96];
+  snprintf(message, sizeof(message), "written %u, retried on full ring %u",
+           log->getWritten(), log->getDropped());
+  TEST_MESSAGE(message);
+  delete log;
+}
+
+// Стоимость вызова на хосте: запись в кольцо против форматирования
+// и вывода в месте вызова. На ESP32 вывод в UART еще и ждет передачи,
+// поэтому разница там больше; команда logbench меряет ее на устройстве
+void test_deferred_log_is_cheaper_than_direct_print() {
+  Logger* log = new Logger();
+  uint32_t deferredMin, deferredMax, deferredAvg;
+  uint32_t directMin, directMax, directAvg;
+
+  // Замеры порциями, чтобы кольцо не переполнялось
+  uint32_t bestDeferred = UINT32_MAX, bestDirect = UINT32_MAX;
+  for (uint8_t round = 0; round < 32; round++) {
+    log->measureOverhead(LOGGER_CAPACITY, false, deferredMin, deferredMax, deferredAvg);
+    log->flush();
+    log->measureOverhead(LOGGER_CAPACITY, true, directMin, directMax, directAvg);
+    Serial.clear();
+    bestDeferred = min(bestDeferred, deferredAvg);
+    bestDirect = min(bestDirect, directAvg);
+  }
+  TEST_ASSERT_EQUAL(0, log->getDropped());
+  TEST_ASSERT_TRUE(bestDeferred < bestDirect);
+
+  char message[96];
+  snprintf(message, sizeof(message), "avg per call: deferred %u ns, direct %u ns",
+           bestDeferred, bestDirect);
+  TEST_MESSAGE(message);
+  delete log;
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_log_defers_formatting_to_flush);
+  RUN_TEST(test_full_ring_drops_without_blocking);
+  RUN_TEST(test_concurrent_producers_deliver_each_record_once);
+  RUN_TEST(test_deferred_log_is_cheaper_than_direct_print);
+  return UNITY_END();
+}
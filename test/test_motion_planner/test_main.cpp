@@ -0,0 +1,121 @@
+#include <unity.h>
+#include <string.h>
+#include "MotionPlanner.h"
+
+void setUp() {}
+void tearDown() {}
+
+static const float DT = MOTION_TICK_MS / 1000.0f;
+
+// Все каналы из одной позиции в одну цель с одинаковым коэффициентом тока
+static MotionPlanState makeState(uint8_t count, float from, int to, float coeff) {
+  MotionPlanState state;
+  memset(&state, 0, sizeof(state));
+  state.count = count;
+  for (uint8_t i = 0; i < count; i++) {
+    state.positions[i] = from;
+    state.targets[i] = to;
+    state.active[i] = true;
+    state.currentPerSpeed[i] = coeff;
+  }
+  return state;
+}
+
+void test_unlimited_move_runs_at_max_speed() {
+  MotionPlanState state = makeState(16, 90, 180, 3.5f);
+  MotionStats stats = MotionPlanner::simulate(state, 1e9f);
+
+  // 90° при 300°/с - 300 мс
+  TEST_ASSERT_EQUAL(300, stats.completionMs);
+  TEST_ASSERT_FLOAT_WITHIN(1.0f, 16 * MOTION_IDLE_CURRENT_MA + 16 * MOTION_MAX_SPEED * 3.5f,
+                           stats.peakCurrent);
+}
+
+void test_budget_is_never_exceeded_and_all_arrive() {
+  const float budget = 2000;
+  MotionPlanState state = makeState(16, 0, 180, 5.0f);
+
+  uint32_t ticks = 0;
+  while (MotionPlanner::isMoving(state) && ticks < 10000) {
+    float current = MotionPlanner::tick(state, DT, budget);
+    TEST_ASSERT_TRUE(current <= budget + 0.01f);
+    ticks++;
+  }
+
+  TEST_ASSERT_FALSE(MotionPlanner::isMoving(state));
+  for (uint8_t i = 0; i < state.count; i++) {
+    TEST_ASSERT_EQUAL(180, state.positions[i]);
+  }
+
+  // Ограничение замедляет перемещение относительно безлимитного
+  MotionStats unlimited = MotionPlanner::simulate(makeState(16, 0, 180, 5.0f), 1e9f);
+  TEST_ASSERT_TRUE(ticks * MOTION_TICK_MS > unlimited.completionMs);
+}
+
+void test_longest_remaining_move_gets_budget_first() {
+  MotionPlanState state = makeState(2, 90, 90, 5.0f);
+  state.targets[0] = 100;  // Короткий ход
+  state.targets[1] = 180;  // Длинный ход
+
+  // Бюджета хватает только на один канал на полной скорости
+  float budget = 2 * MOTION_IDLE_CURRENT_MA + MOTION_MAX_SPEED * 5.0f;
+  MotionPlanner::tick(state, DT, budget);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 90 + MOTION_MAX_SPEED * DT, state.positions[1]);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 90, state.positions[0]);
+}
+
+void test_budget_below_idle_current_does_not_move() {
+  MotionPlanState state = makeState(16, 90, 0, 3.5f);
+  MotionStats stats = MotionPlanner::simulate(state, 100, 1000);
+  TEST_ASSERT_EQUAL(1000, stats.completionMs);
+
+  MotionPlanner::tick(state, DT, 100);
+  TEST_ASSERT_TRUE(MotionPlanner::isMoving(state));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 90, state.positions[0]);
+}
+
+void test_merge_keeps_target_set_during_tick() {
+  MotionPlanState shared = makeState(1, 179, 180, 3.5f);
+
+  // Такт рассчитывается по снимку и завершает старое перемещение
+  MotionPlanState snapshot = shared;
+  MotionPlanState planned = snapshot;
+  MotionPlanner::tick(planned, DT, 1e9f);
+  TEST_ASSERT_FALSE(planned.active[0]);
+
+  // Тем временем пришла новая команда
+  shared.targets[0] = 0;
+  shared.active[0] = true;
+
+  MotionPlanner::merge(shared, snapshot, planned);
+  TEST_ASSERT_TRUE(shared.active[0]);
+  TEST_ASSERT_EQUAL(0, shared.targets[0]);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 180, shared.positions[0]);
+}
+
+void test_merge_completes_unchanged_target_and_keeps_stop() {
+  MotionPlanState shared = makeState(2, 179, 180, 3.5f);
+  MotionPlanState snapshot = shared;
+  MotionPlanState planned = snapshot;
+  MotionPlanner::tick(planned, DT, 1e9f);
+
+  // Канал 1 остановили во время такта
+  shared.active[1] = false;
+
+  MotionPlanner::merge(shared, snapshot, planned);
+  TEST_ASSERT_FALSE(shared.active[0]);
+  TEST_ASSERT_FALSE(shared.active[1]);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 180, shared.positions[0]);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_unlimited_move_runs_at_max_speed);
+  RUN_TEST(test_budget_is_never_exceeded_and_all_arrive);
+  RUN_TEST(test_longest_remaining_move_gets_budget_first);
+  RUN_TEST(test_budget_below_idle_current_does_not_move);
+  RUN_TEST(test_merge_keeps_target_set_during_tick);
+  RUN_TEST(test_merge_completes_unchanged_target_and_keeps_stop);
+  return UNITY_END();
+}
\ No newline at end of file
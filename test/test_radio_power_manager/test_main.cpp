@@ -0,0 +1,149 @@
+#include <unity.h>
+#include "RadioPowerManager.h"
+#include "FlightRecorder.h"
+#include "Logger.h"
+
+// Радиомодуль, запоминающий вызовы
+class FakeRadioLink : public RadioLink {
+public:
+  int apStarts = 0;
+  int stationStarts = 0;
+  int stops = 0;
+  bool powerSave = false;
+  bool powerSaveAp = false;
+  bool connected = false;
+  String ssid;
+
+  void startAccessPoint(const String& s, const String&) override { apStarts++; ssid = s; }
+  void startStation(const String& s, const String&) override { stationStarts++; ssid = s; }
+  void stop() override { stops++; connected = false; }
+  void setPowerSave(bool apMode, bool enabled) override {
+    powerSaveAp = apMode;
+    powerSave = enabled;
+  }
+  bool isConnected() const override { return connected; }
+  int status() const override { return 6; }
+  uint32_t localAddress(bool apMode) const override {
+    // 192.168.4.1 для точки доступа, 192.168.1.20 для станции
+    return apMode ? 0x0104A8C0 : 0x1401A8C0;
+  }
+};
+
+static FakeRadioLink* radioLink;
+static RadioPowerManager* radio;
+
+void setUp() {
+  radioLink = new FakeRadioLink();
+  radio = new RadioPowerManager(radioLink);
+  logger.flush();
+  Serial.clear();
+}
+
+void tearDown() {
+  delete radio;
+  delete radioLink;
+}
+
+void test_power_change_keeps_link() {
+  radio->configure("robot", "secret", true);
+  radio->setState(RADIO_MODEM_SLEEP);
+  TEST_ASSERT_EQUAL(1, radioLink->apStarts);
+  TEST_ASSERT_TRUE(radioLink->powerSave);
+  TEST_ASSERT_TRUE(radioLink->powerSaveAp);
+  TEST_ASSERT_TRUE(radio->isLinkUp());
+
+  // Выход из энергосбережения и обратно без перезапуска связи
+  radio->setState(RADIO_FULL_POWER);
+  TEST_ASSERT_FALSE(radioLink->powerSave);
+  radio->setState(RADIO_MODEM_SLEEP);
+  TEST_ASSERT_TRUE(radioLink->powerSave);
+  TEST_ASSERT_EQUAL(1, radioLink->apStarts);
+  TEST_ASSERT_EQUAL(0, radioLink->stops);
+
+  radio->setState(RADIO_OFF);
+  TEST_ASSERT_EQUAL(1, radioLink->stops);
+  TEST_ASSERT_FALSE(radio->isLinkUp());
+}
+
+void test_same_parameters_do_not_restart_link() {
+  radio->configure("robot", "secret", true);
+  radio->setState(RADIO_MODEM_SLEEP);
+
+  radio->configure("robot", "secret", true);
+  TEST_ASSERT_EQUAL(1, radioLink->apStarts);
+  TEST_ASSERT_EQUAL(0, radioLink->stops);
+}
+
+void test_changed_parameters_restart_link_in_same_power_state() {
+  radio->configure("robot", "secret", true);
+  radio->setState(RADIO_MODEM_SLEEP);
+
+  radio->configure("home", "password", false);
+  TEST_ASSERT_EQUAL(1, radioLink->stops);
+  TEST_ASSERT_EQUAL(1, radioLink->stationStarts);
+  TEST_ASSERT_EQUAL_STRING("home", radioLink->ssid.c_str());
+  TEST_ASSERT_TRUE(radioLink->powerSave);
+  TEST_ASSERT_FALSE(radioLink->powerSaveAp);
+  TEST_ASSERT_EQUAL(RADIO_MODEM_SLEEP, radio->getState());
+}
+
+void test_configure_while_off_does_not_start_link() {
+  radio->configure("home", "password", false);
+  TEST_ASSERT_EQUAL(0, radioLink->apStarts + radioLink->stationStarts);
+  TEST_ASSERT_FALSE(radio->isLinkUp());
+}
+
+void test_station_connects_without_blocking() {
+  radio->configure("home", "password", false);
+  radio->setState(RADIO_FULL_POWER);
+  TEST_ASSERT_FALSE(radio->isLinkUp());
+
+  radioLink->connected = true;
+  radio->update();
+  TEST_ASSERT_TRUE(radio->isLinkUp());
+
+  logger.flush();
+  TEST_ASSERT_TRUE(Serial.output.find("IP Address: 192.168.1.20") != std::string::npos);
+}
+
+void test_station_connect_timeout_is_recorded() {
+  radio->configure("home", "password", false);
+  radio->setState(RADIO_FULL_POWER);
+  uint32_t before = flightRecorder.getTotalRecords();
+
+  stubAdvanceMicros((RADIO_CONNECT_TIMEOUT_MS - 1) * 1000UL);
+  radio->update();
+  TEST_ASSERT_EQUAL(before, flightRecorder.getTotalRecords());
+
+  stubAdvanceMicros(2000);
+  radio->update();
+  TEST_ASSERT_EQUAL(before + 1, flightRecorder.getTotalRecords());
+
+  // Ошибка фиксируется один раз
+  stubAdvanceMicros(RADIO_CONNECT_TIMEOUT_MS * 1000UL);
+  radio->update();
+  TEST_ASSERT_EQUAL(before + 1, flightRecorder.getTotalRecords());
+}
+
+void test_residency_counts_time_in_each_state() {
+  radio->configure("robot", "secret", true);
+  radio->setState(RADIO_MODEM_SLEEP);
+  stubAdvanceMicros(300000);
+  radio->setState(RADIO_FULL_POWER);
+  stubAdvanceMicros(100000);
+
+  TEST_ASSERT_EQUAL(300, radio->getResidencyMs(RADIO_MODEM_SLEEP));
+  TEST_ASSERT_EQUAL(100, radio->getResidencyMs(RADIO_FULL_POWER));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_power_change_keeps_link);
+  RUN_TEST(test_same_parameters_do_not_restart_link);
+  RUN_TEST(test_changed_parameters_restart_link_in_same_power_state);
+  RUN_TEST(test_configure_while_off_does_not_start_link);
+  RUN_TEST(test_station_connects_without_blocking);
+  RUN_TEST(test_station_connect_timeout_is_recorded);
+  RUN_TEST(test_residency_counts_time_in_each_state);
+  return UNITY_END();
+}
@@ -0,0 +1,191 @@
+#include <unity.h>
+#include "RobotModel.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Прямая кинематика ноги для проверки решения (та же система координат)
+template <class Robot>
+static FootTarget forwardKinematics(uint8_t legIndex, const LegAngles& angles) {
+  const robot::Leg& leg = Robot::legs[legIndex];
+  float coxa = angles.coxa * DEG_TO_RAD;
+  float hip = angles.femur * DEG_TO_RAD;
+  float tibia = angles.tibia * DEG_TO_RAD;
+
+  // Бедро и голень в плоскости ноги (x - вперед, f - от конца coxa)
+  float x = leg.femurLength * sinf(hip) + leg.tibiaLength * sinf(hip - tibia);
+  float f = leg.femurLength * cosf(hip) + leg.tibiaLength * cosf(hip - tibia);
+
+  // Поворот плоскости ноги вокруг оси x на угол отведения
+  FootTarget foot;
+  foot.x = x;
+  foot.y = leg.coxaLength * cosf(coxa) - f * sinf(coxa);
+  foot.z = leg.coxaLength * sinf(coxa) + f * cosf(coxa);
+  return foot;
+}
+
+template <class Robot>
+static void assertSolvesAndRoundTrips(float x, float yOffset, float z) {
+  typedef RobotModel<Robot> Model;
+  FootTarget feet[Robot::legCount];
+  Model::standingFeet(z, feet);
+  for (uint8_t i = 0; i < Robot::legCount; i++) {
+    feet[i].x += x;
+    feet[i].y += yOffset;
+  }
+
+  LegAngles angles[Robot::legCount];
+  TEST_ASSERT_TRUE(Model::solve(feet, angles));
+  for (uint8_t i = 0; i < Robot::legCount; i++) {
+    FootTarget foot = forwardKinematics<Robot>(i, angles[i]);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, feet[i].x, foot.x);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, feet[i].y, foot.y);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, feet[i].z, foot.z);
+  }
+}
+
+void test_quadspot_solves_reachable_poses() {
+  assertSolvesAndRoundTrips<robot::QuadSpot>(0, 0, 180);
+  assertSolvesAndRoundTrips<robot::QuadSpot>(40, 10, 150);
+  assertSolvesAndRoundTrips<robot::QuadSpot>(-30, -10, 200);
+}
+
+void test_mini_solves_reachable_poses() {
+  assertSolvesAndRoundTrips<robot::QuadSpotMini>(0, 0, 130);
+  assertSolvesAndRoundTrips<robot::QuadSpotMini>(30, 5, 110);
+}
+
+template <class Robot>
+static void assertRejectsUnreachable() {
+  typedef RobotModel<Robot> Model;
+  const robot::Leg& leg = Robot::legs[0];
+  FootTarget feet[Robot::legCount];
+  LegAngles angles[Robot::legCount];
+
+  // Дальше суммы длин бедра и голени
+  Model::standingFeet(leg.femurLength + leg.tibiaLength + 10, feet);
+  TEST_ASSERT_FALSE(Model::solve(feet, angles));
+
+  // Внутри звена отведения
+  Model::standingFeet(0, feet);
+  feet[0].y = leg.coxaLength / 2;
+  TEST_ASSERT_FALSE(Model::solve(feet, angles));
+}
+
+void test_unreachable_points_are_rejected() {
+  assertRejectsUnreachable<robot::QuadSpot>();
+  assertRejectsUnreachable<robot::QuadSpotMini>();
+}
+
+void test_joint_to_servo_applies_direction_and_limits() {
+  typedef RobotModel<robot::QuadSpot> Model;
+  const robot::Leg& left = robot::QuadSpot::legs[0];
+  const robot::Leg& right = robot::QuadSpot::legs[1];
+
+  TEST_ASSERT_EQUAL(120, Model::jointToServo(left.femur, 30));
+  TEST_ASSERT_EQUAL(60, Model::jointToServo(right.femur, 30));
+  // Угол за пределом сустава ограничивается пределом
+  TEST_ASSERT_EQUAL(135, Model::jointToServo(left.coxa, 80));
+  TEST_ASSERT_EQUAL(20, Model::jointToServo(right.tibia, 170));
+
+  // Пределы сервопривода вычисляются на этапе компиляции
+  static_assert(Model::servoMin(robot::QuadSpot::legs[1].tibia) == 20, "right tibia min");
+  static_assert(Model::servoMax(robot::QuadSpot::legs[1].tibia) == 180, "right tibia max");
+  static_assert(Model::servoMin(robot::QuadSpot::legs[0].coxa) == 45, "left coxa min");
+  static_assert(RobotModel<robot::QuadSpotMini>::servoMax(robot::QuadSpotMini::legs[0].tibia) == 150,
+                "mini left tibia max");
+}
+
+// Выдача стойки через планировщик на сервоприводы своих каналов
+template <class Robot>
+static void assertCommitReachesChannels(float height) {
+  typedef RobotModel<Robot> Model;
+  ServoController servoController(21, 22);
+  servoController.begin();
+  MotionScheduler motionScheduler(&servoController);
+  motionScheduler.begin();
+  Model::applyLimits(motionScheduler);
+  motionScheduler.setLimitsEnabled(true);
+
+  FootTarget feet[Robot::legCount];
+  Model::standingFeet(height, feet);
+  TEST_ASSERT_TRUE(Model::moveFeet(motionScheduler, feet));
+  for (uint32_t t = 0; t < 3000 && motionScheduler.isMoving(); t++) {
+    motionScheduler.update();
+    stubAdvanceMicros(1000);
+  }
+  TEST_ASSERT_FALSE(motionScheduler.isMoving());
+
+  LegAngles angles[Robot::legCount];
+  Model::solve(feet, angles);
+  bool used[16] = {};
+  for (uint8_t i = 0; i < Robot::legCount; i++) {
+    const robot::Leg& leg = Robot::legs[i];
+    TEST_ASSERT_EQUAL(Model::jointToServo(leg.coxa, angles[i].coxa),
+                      servoController.getCurrentPosition(leg.coxa.channel));
+    TEST_ASSERT_EQUAL(Model::jointToServo(leg.femur, angles[i].femur),
+                      servoController.getCurrentPosition(leg.femur.channel));
+    TEST_ASSERT_EQUAL(Model::jointToServo(leg.tibia, angles[i].tibia),
+                      servoController.getCurrentPosition(leg.tibia.channel));
+    used[leg.coxa.channel] = used[leg.femur.channel] = used[leg.tibia.channel] = true;
+  }
+
+  // Каналы вне описания робота не двигаются
+  for (uint8_t channel = 0; channel < 16; channel++) {
+    if (!used[channel]) {
+      TEST_ASSERT_EQUAL(90, servoController.getCurrentPosition(channel));
+    }
+  }
+}
+
+void test_quadspot_commit_reaches_channels() {
+  assertCommitReachesChannels<robot::QuadSpot>(180);
+}
+
+void test_mini_commit_reaches_channels() {
+  assertCommitReachesChannels<robot::QuadSpotMini>(130);
+}
+
+void test_scheduler_limits_follow_joint_limits() {
+  typedef RobotModel<robot::QuadSpotMini> Model;
+  ServoController servoController(21, 22);
+  servoController.begin();
+  MotionScheduler motionScheduler(&servoController);
+  motionScheduler.begin();
+  Model::applyLimits(motionScheduler);
+
+  const uint8_t rightTibia = robot::QuadSpotMini::legs[1].tibia.channel;
+  const uint8_t unused = 3;
+
+  // С пределами: правая голень не опускается ниже 30, свободный канал - без ограничений
+  motionScheduler.setLimitsEnabled(true);
+  motionScheduler.moveTo(rightTibia, 0);
+  motionScheduler.moveTo(unused, 0);
+  for (uint32_t t = 0; t < 2000; t++) {
+    motionScheduler.update();
+    stubAdvanceMicros(1000);
+  }
+  TEST_ASSERT_EQUAL(30, servoController.getCurrentPosition(rightTibia));
+  TEST_ASSERT_EQUAL(0, servoController.getCurrentPosition(unused));
+
+  // Режим калибровки: доступен весь диапазон
+  motionScheduler.setLimitsEnabled(false);
+  motionScheduler.moveTo(rightTibia, 0);
+  for (uint32_t t = 0; t < 2000; t++) {
+    motionScheduler.update();
+    stubAdvanceMicros(1000);
+  }
+  TEST_ASSERT_EQUAL(0, servoController.getCurrentPosition(rightTibia));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_quadspot_solves_reachable_poses);
+  RUN_TEST(test_mini_solves_reachable_poses);
+  RUN_TEST(test_unreachable_points_are_rejected);
+  RUN_TEST(test_joint_to_servo_applies_direction_and_limits);
+  RUN_TEST(test_quadspot_commit_reaches_channels);
+  RUN_TEST(test_mini_commit_reaches_channels);
+  RUN_TEST(test_scheduler_limits_follow_joint_limits);
+  return UNITY_END();
+}
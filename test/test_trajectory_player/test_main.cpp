@@ -0,0 +1,239 @@
+#include <unity.h>
+#include "TrajectoryPlayer.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Генератор задержек сети: одинаковые трассы на любой платформе
+static uint32_t rngState;
+static uint32_t nextRandom(uint32_t howbig) {
+  rngState = rngState * 1664525u + 1013904223u;
+  return (rngState >> 8) % howbig;
+}
+
+// Синусоида: период 2 с, размах ±45° от центра
+static const float PERIOD_MS = 2000.0f;
+static const float AMPLITUDE = 45.0f;
+static const float IDEAL_STEP = AMPLITUDE * 2.0f * PI / PERIOD_MS * TRAJ_TICK_MS;
+// Часы отправителя не совпадают с локальными
+static const uint32_t SENDER_CLOCK_OFFSET = 123456;
+
+struct ReplayResult {
+  float maxStepDirect;    // Макс. скачок угла за такт при немедленном применении
+  float maxStepPlayer;    // Макс. скачок угла за такт через буфер воспроизведения
+  uint32_t underruns;      // Провалы за всю трассу
+  uint32_t steadyUnderruns;  // Провалы после подстройки задержки
+  float steadyStepPlayer;    // Макс. скачок через буфер после подстройки задержки
+  uint32_t late;
+  float playoutDelayMs;
+};
+
+static uint8_t angleAt(uint32_t senderMs) {
+  return (uint8_t)lroundf(90.0f + AMPLITUDE * sinf(2.0f * PI * senderMs / PERIOD_MS));
+}
+
+// Воспроизведение трассы: кадры каждые frameMs, сеть задерживает их
+// случайно до jitterMs, сохраняя порядок (кадры приходят пачками).
+// Первые WARMUP_MS задержка воспроизведения подстраивается под джиттер
+static const uint32_t WARMUP_MS = 3000;
+
+static ReplayResult replay(uint16_t frameMs, uint16_t jitterMs, uint32_t durationMs) {
+  TrajectoryPlayer player(nullptr);
+  player.start();
+  rngState = 12345;
+
+  ReplayResult result = { 0, 0, 0, 0, 0, 0, 0 };
+  uint32_t warmupUnderruns = 0;
+  const uint8_t maxInFlight = 16;
+  uint32_t sendTimes[maxInFlight];
+  uint32_t arrivalTimes[maxInFlight];
+  uint8_t inFlightHead = 0, inFlightCount = 0;
+  uint32_t nextSendMs = 0;
+  uint32_t lastArrivalMs = 0;
+
+  int lastDirect = -1, lastPlayer = -1;
+  uint8_t direct = 90;
+
+  for (uint32_t now = 0; now < durationMs; now++) {
+    if (now >= nextSendMs && inFlightCount < maxInFlight) {
+      uint8_t slot = (inFlightHead + inFlightCount) % maxInFlight;
+      sendTimes[slot] = nextSendMs;
+      arrivalTimes[slot] = max(lastArrivalMs, nextSendMs + 2 + nextRandom(jitterMs + 1));
+      lastArrivalMs = arrivalTimes[slot];
+      inFlightCount++;
+      nextSendMs += frameMs;
+    }
+
+    while (inFlightCount > 0 && now >= arrivalTimes[inFlightHead]) {
+      uint32_t sentMs = sendTimes[inFlightHead];
+      uint8_t positions[TRAJ_SERVO_COUNT];
+      memset(positions, angleAt(sentMs), TRAJ_SERVO_COUNT);
+
+      player.pushFrame(sentMs + SENDER_CLOCK_OFFSET, positions, TRAJ_SERVO_COUNT, now);
+      direct = positions[0];
+      inFlightHead = (inFlightHead + 1) % maxInFlight;
+      inFlightCount--;
+    }
+
+    if (now % TRAJ_TICK_MS == 0) {
+      uint8_t positions[TRAJ_SERVO_COUNT];
+      if (player.sample(now, positions)) {
+        if (lastPlayer >= 0) {
+          float step = (float)abs(positions[0] - lastPlayer);
+          result.maxStepPlayer = max(result.maxStepPlayer, step);
+          if (now >= WARMUP_MS) {
+            result.steadyStepPlayer = max(result.steadyStepPlayer, step);
+          }
+        }
+        lastPlayer = positions[0];
+      }
+      if (lastDirect >= 0) {
+        result.maxStepDirect = max(result.maxStepDirect, (float)abs(direct - lastDirect));
+      }
+      lastDirect = direct;
+    }
+
+    if (now == WARMUP_MS) {
+      warmupUnderruns = player.getStats().underruns;
+    }
+  }
+
+  TrajectoryStats stats = player.getStats();
+  result.underruns = stats.underruns;
+  result.steadyUnderruns = stats.underruns - warmupUnderruns;
+  result.late = stats.late;
+  result.playoutDelayMs = stats.playoutDelayMs;
+
+  char message[160];
+  snprintf(message, sizeof(message),
+           "jitter %u ms: step direct %.0f, player %.0f/%.0f (ideal %.1f), "
+           "underruns %u/%u, delay %.0f ms",
+           jitterMs, result.maxStepDirect, result.maxStepPlayer, result.steadyStepPlayer,
+           IDEAL_STEP, result.underruns, result.steadyUnderruns, result.playoutDelayMs);
+  TEST_MESSAGE(message);
+  return result;
+}
+
+// Плавное движение: за такт не больше шага исходной траектории,
+// округленного до целого градуса
+static const float SMOOTH_STEP = ceilf(IDEAL_STEP);
+
+void test_replay_without_jitter() {
+  ReplayResult r = replay(20, 0, 20000);
+  TEST_ASSERT_EQUAL(0, r.underruns);
+  TEST_ASSERT_EQUAL(0, r.late);
+  TEST_ASSERT_TRUE(r.maxStepPlayer <= SMOOTH_STEP);
+  TEST_ASSERT_TRUE(r.playoutDelayMs <= TRAJ_MIN_DELAY_MS + 20 + 5);
+}
+
+// Умеренный джиттер: после подстройки задержки провалов нет
+static void assertSmoothAfterWarmup(uint16_t jitterMs) {
+  ReplayResult r = replay(20, jitterMs, 20000);
+  TEST_ASSERT_EQUAL(0, r.steadyUnderruns);
+  TEST_ASSERT_TRUE(r.steadyStepPlayer <= SMOOTH_STEP);
+  TEST_ASSERT_TRUE(r.maxStepPlayer < r.maxStepDirect);
+  TEST_ASSERT_TRUE(r.playoutDelayMs > jitterMs);
+  TEST_ASSERT_TRUE(r.playoutDelayMs <= TRAJ_MAX_DELAY_MS);
+}
+
+void test_replay_with_jitter_20ms() {
+  assertSmoothAfterWarmup(20);
+}
+
+void test_replay_with_jitter_50ms() {
+  assertSmoothAfterWarmup(50);
+}
+
+// Джиттер у предела задержки: единичные провалы допустимы,
+// но движение остается заметно плавнее немедленного применения
+void test_replay_with_jitter_100ms() {
+  ReplayResult r = replay(20, 100, 20000);
+  TEST_ASSERT_TRUE(r.steadyUnderruns <= 2);
+  TEST_ASSERT_TRUE(r.steadyStepPlayer <= SMOOTH_STEP + 1);
+  TEST_ASSERT_TRUE(r.steadyStepPlayer * 2 < r.maxStepDirect);
+  TEST_ASSERT_TRUE(r.playoutDelayMs > 100);
+}
+
+// Воспроизведение через loop(): кадры доходят до PCA9685
+// через планировщик перемещений
+void test_update_drives_servos_through_scheduler() {
+  ServoController servoController(21, 22);
+  servoController.begin();
+  MotionScheduler motionScheduler(&servoController);
+  motionScheduler.begin();
+  TrajectoryPlayer player(&motionScheduler);
+  player.start();
+  // Соседний канал стоит не в центре
+  servoController.setPosition(3, 30);
+
+  // Одна нога: бюджет тока позволяет идти по траектории без ограничения скорости
+  const uint8_t channels = 3;
+  uint32_t startMs = millis();
+  uint32_t maxError = 0;
+  for (uint32_t t = 0; t < 4000; t++) {
+    if (t % 20 == 0) {
+      uint8_t positions[channels];
+      memset(positions, angleAt(t), channels);
+      player.pushFrame(t + SENDER_CLOCK_OFFSET, positions, channels, millis());
+    }
+    player.update();
+    motionScheduler.update();
+
+    // После заполнения буфера сервопривод повторяет траекторию с задержкой
+    // воспроизведения; расхождение - из-за тактов воспроизведения и планировщика
+    uint32_t elapsed = millis() - startMs;
+    if (elapsed >= 1000) {
+      int expected = angleAt(elapsed - (uint32_t)player.getStats().playoutDelayMs);
+      uint32_t error = abs(servoController.getCurrentPosition(channels - 1) - expected);
+      maxError = max(maxError, error);
+    }
+    stubAdvanceMicros(1000);
+  }
+
+  TEST_ASSERT_TRUE(maxError <= 3);
+  // Каналы, не переданные в кадрах, не двигаются
+  TEST_ASSERT_EQUAL(30, servoController.getCurrentPosition(channels));
+  TEST_ASSERT_EQUAL(0, player.getStats().underruns);
+}
+
+// Каналы, которых нет в потоке, остаются на месте; канал, появившийся
+// в потоке позже, сразу идет к переданному значению
+void test_channels_missing_from_stream_stay_in_place() {
+  ServoController servoController(21, 22);
+  servoController.begin();
+  MotionScheduler motionScheduler(&servoController);
+  motionScheduler.begin();
+  servoController.setPosition(3, 30);
+  servoController.setPosition(5, 30);
+  TrajectoryPlayer player(&motionScheduler);
+  player.start();
+
+  int maxLateChannel = 0;
+  for (uint32_t t = 0; t < 2000; t++) {
+    if (t % 20 == 0) {
+      // Первую секунду поток несет каналы 0-2, затем еще и канал 3
+      uint8_t positions[4] = { 120, 120, 120, 40 };
+      player.pushFrame(t + SENDER_CLOCK_OFFSET, positions, t < 1000 ? 3 : 4, millis());
+    }
+    player.update();
+    motionScheduler.update();
+    maxLateChannel = max(maxLateChannel, servoController.getCurrentPosition(3));
+    TEST_ASSERT_EQUAL(30, servoController.getCurrentPosition(5));
+    stubAdvanceMicros(1000);
+  }
+
+  TEST_ASSERT_EQUAL(120, servoController.getCurrentPosition(0));
+  TEST_ASSERT_EQUAL(40, servoController.getCurrentPosition(3));
+  TEST_ASSERT_EQUAL(40, maxLateChannel);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_replay_without_jitter);
+  RUN_TEST(test_replay_with_jitter_20ms);
+  RUN_TEST(test_replay_with_jitter_50ms);
+  RUN_TEST(test_replay_with_jitter_100ms);
+  RUN_TEST(test_update_drives_servos_through_scheduler);
+  RUN_TEST(test_channels_missing_from_stream_stay_in_place);
+  return UNITY_END();
+}
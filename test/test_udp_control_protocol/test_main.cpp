@@ -0,0 +1,233 @@
+#include <unity.h>
+#include <string.h>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "UdpControlProtocol.h"
+
+// Петля через UDP-сокеты хоста: отправитель с выбрасыванием и
+// перестановкой пакетов, приемник передает пакеты в UdpControlProtocol
+static int sender = -1;
+static int receiver = -1;
+static sockaddr_in receiverAddr;
+
+void setUp() {
+  receiver = socket(AF_INET, SOCK_DGRAM, 0);
+  sender = socket(AF_INET, SOCK_DGRAM, 0);
+  TEST_ASSERT_TRUE(receiver >= 0 && sender >= 0);
+
+  memset(&receiverAddr, 0, sizeof(receiverAddr));
+  receiverAddr.sin_family = AF_INET;
+  receiverAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  receiverAddr.sin_port = 0;  // Свободный порт
+  TEST_ASSERT_EQUAL(0, bind(receiver, (sockaddr*)&receiverAddr, sizeof(receiverAddr)));
+  socklen_t addrLen = sizeof(receiverAddr);
+  getsockname(receiver, (sockaddr*)&receiverAddr, &addrLen);
+
+  timeval timeout = { 0, 200000 };
+  setsockopt(receiver, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  int size = 1 << 20;
+  setsockopt(receiver, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+}
+
+void tearDown() {
+  close(sender);
+  close(receiver);
+}
+
+static std::vector<uint8_t> posePacket(uint32_t seq, uint8_t session, uint32_t token = 0) {
+  UdpControlHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic[0] = 'Q';
+  header.magic[1] = 'S';
+  header.version = UDP_CONTROL_VERSION;
+  header.type = UDP_PACKET_POSE;
+  header.seq = seq;
+  header.token = token;
+  header.count = UDP_CONTROL_CHANNELS;
+  header.session = session;
+
+  std::vector<uint8_t> packet(sizeof(header) + UDP_CONTROL_CHANNELS, 90);
+  memcpy(packet.data(), &header, sizeof(header));
+  return packet;
+}
+
+static void sendPacket(const std::vector<uint8_t>& packet) {
+  sendto(sender, packet.data(), packet.size(), 0, (sockaddr*)&receiverAddr, sizeof(receiverAddr));
+}
+
+// Прием всех дошедших пакетов; возвращает количество
+static uint32_t receiveAll(UdpControlProtocol& protocol, uint32_t nowMs) {
+  uint8_t buffer[256];
+  uint32_t count = 0;
+  ssize_t len;
+  while ((len = recv(receiver, buffer, sizeof(buffer), 0)) > 0) {
+    UdpControlHeader header;
+    protocol.accept(buffer, len, 0, nowMs, header);
+    count++;
+  }
+  return count;
+}
+
+// Поток seq 1..count: каждый dropEvery-й пакет выбрасывается, каждый
+// reorderEvery-й отправляется после следующего
+struct StreamResult {
+  uint32_t sent;
+  uint32_t dropped;
+  uint32_t reordered;
+};
+
+static StreamResult sendStream(uint32_t count, uint8_t session, uint32_t dropEvery,
+                               uint32_t reorderEvery) {
+  StreamResult result = { 0, 0, 0 };
+  std::vector<uint8_t> held;
+  for (uint32_t seq = 1; seq <= count; seq++) {
+    std::vector<uint8_t> packet = posePacket(seq, session);
+    if (dropEvery && seq % dropEvery == 0 && seq != count) {
+      result.dropped++;
+    } else if (reorderEvery && seq % reorderEvery == 0 && held.empty() && seq != count) {
+      held = packet;
+      result.reordered++;
+    } else {
+      sendPacket(packet);
+      result.sent++;
+      if (!held.empty()) {
+        sendPacket(held);
+        result.sent++;
+        held.clear();
+      }
+    }
+  }
+  return result;
+}
+
+void test_loss_is_counted_once() {
+  UdpControlProtocol protocol;
+  StreamResult stream = sendStream(500, 7, 10, 0);
+  TEST_ASSERT_EQUAL(stream.sent, receiveAll(protocol, 1000));
+
+  const UdpControlStats& stats = protocol.getStats();
+  TEST_ASSERT_EQUAL(stream.sent, stats.accepted);
+  TEST_ASSERT_EQUAL(stream.dropped, stats.lost);
+  TEST_ASSERT_EQUAL(0, stats.reordered);
+  TEST_ASSERT_EQUAL(0, stats.stale);
+}
+
+void test_reordered_packets_are_not_lost() {
+  UdpControlProtocol protocol;
+  StreamResult stream = sendStream(500, 7, 10, 7);
+  TEST_ASSERT_EQUAL(stream.sent, receiveAll(protocol, 1000));
+
+  // Переставленный пакет не применяется (уже есть более новый),
+  // но и не считается ни потерянным, ни устаревшим
+  const UdpControlStats& stats = protocol.getStats();
+  TEST_ASSERT_EQUAL(stream.reordered, stats.reordered);
+  TEST_ASSERT_EQUAL(stream.dropped, stats.lost);
+  TEST_ASSERT_EQUAL(stream.sent - stream.reordered, stats.accepted);
+  TEST_ASSERT_EQUAL(0, stats.stale);
+}
+
+void test_duplicates_are_stale() {
+  UdpControlProtocol protocol;
+  for (uint32_t seq = 1; seq <= 10; seq++) {
+    sendPacket(posePacket(seq, 7));
+    sendPacket(posePacket(seq, 7));
+  }
+  receiveAll(protocol, 1000);
+
+  const UdpControlStats& stats = protocol.getStats();
+  TEST_ASSERT_EQUAL(10, stats.accepted);
+  TEST_ASSERT_EQUAL(10, stats.stale);
+  TEST_ASSERT_EQUAL(0, stats.lost);
+}
+
+void test_restarted_sender_with_new_session_is_accepted() {
+  UdpControlProtocol protocol;
+  sendStream(500, 7, 0, 0);
+  receiveAll(protocol, 1000);
+
+  // Второй запуск udp_teleop.py: номера снова с 1, другой сеанс
+  sendStream(500, 8, 0, 0);
+  receiveAll(protocol, 1100);
+
+  const UdpControlStats& stats = protocol.getStats();
+  TEST_ASSERT_EQUAL(1000, stats.accepted);
+  TEST_ASSERT_EQUAL(0, stats.stale);
+  TEST_ASSERT_EQUAL(0, stats.lost);
+  TEST_ASSERT_EQUAL(1, stats.restarts);
+}
+
+void test_restarted_sender_without_session_after_pause() {
+  UdpControlProtocol protocol;
+  sendStream(500, 0, 0, 0);
+  receiveAll(protocol, 1000);
+
+  // Отправитель без номера сеанса: откат номера без паузы отбрасывается
+  sendStream(10, 0, 0, 0);
+  receiveAll(protocol, 1000 + UDP_SEQ_IDLE_RESET_MS);
+  TEST_ASSERT_EQUAL(500, protocol.getStats().accepted);
+  TEST_ASSERT_EQUAL(10, protocol.getStats().stale);
+
+  // После паузы поток номеров начинается заново
+  sendStream(500, 0, 0, 0);
+  receiveAll(protocol, 1000 + 3 * UDP_SEQ_IDLE_RESET_MS);
+  TEST_ASSERT_EQUAL(1000, protocol.getStats().accepted);
+  TEST_ASSERT_EQUAL(1, protocol.getStats().restarts);
+}
+
+void test_reordered_pair_at_stream_start_is_stale() {
+  UdpControlProtocol protocol;
+  // Первые два пакета потока переставлены сетью
+  sendPacket(posePacket(2, 7));
+  sendPacket(posePacket(1, 7));
+  for (uint32_t seq = 3; seq <= 10; seq++) {
+    sendPacket(posePacket(seq, 7));
+  }
+  receiveAll(protocol, 1000);
+
+  // То же после перезапуска отправителя с новым сеансом
+  sendPacket(posePacket(2, 8));
+  sendPacket(posePacket(1, 8));
+  sendPacket(posePacket(3, 8));
+  receiveAll(protocol, 1100);
+
+  const UdpControlStats& stats = protocol.getStats();
+  TEST_ASSERT_EQUAL(0, stats.lost);
+  TEST_ASSERT_EQUAL(0, stats.reordered);
+  TEST_ASSERT_EQUAL(2, stats.stale);
+  TEST_ASSERT_EQUAL(11, stats.accepted);
+  TEST_ASSERT_EQUAL(1, stats.restarts);
+}
+
+void test_wrong_token_and_malformed_are_rejected() {
+  UdpControlProtocol protocol;
+  UdpControlHeader header;
+
+  std::vector<uint8_t> packet = posePacket(1, 7, 1234);
+  TEST_ASSERT_FALSE(protocol.accept(packet.data(), packet.size(), 4321, 0, header));
+  TEST_ASSERT_TRUE(protocol.accept(packet.data(), packet.size(), 1234, 0, header));
+
+  // Нагрузка короче заявленного количества каналов
+  packet = posePacket(2, 7);
+  TEST_ASSERT_FALSE(protocol.accept(packet.data(), packet.size() - 1, 0, 0, header));
+
+  const UdpControlStats& stats = protocol.getStats();
+  TEST_ASSERT_EQUAL(1, stats.authFailed);
+  TEST_ASSERT_EQUAL(1, stats.malformed);
+  TEST_ASSERT_EQUAL(1, stats.accepted);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_loss_is_counted_once);
+  RUN_TEST(test_reordered_packets_are_not_lost);
+  RUN_TEST(test_duplicates_are_stale);
+  RUN_TEST(test_restarted_sender_with_new_session_is_accepted);
+  RUN_TEST(test_restarted_sender_without_session_after_pause);
+  RUN_TEST(test_reordered_pair_at_stream_start_is_stale);
+  RUN_TEST(test_wrong_token_and_malformed_are_rejected);
+  return UNITY_END();
+}
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Декодер бортового журнала (GET /api/flightlog).
+
+Использование:
+    curl -o flightlog.bin http://<ip>/api/flightlog
+    python3 tools/flightlog_decode.py flightlog.bin [--csv]
+
+Формат описан в src/FlightRecorder.h.
+"""
+
+import argparse
+import struct
+import sys
+
+HEADER = struct.Struct("<4sHHIII")
+RECORD = struct.Struct("<IBBhI")
+
+EVENT_TYPES = {
+    1: "POSE",
+    2: "PWM_COMMIT",
+    3: "COMMAND",
+    4: "FAULT",
+    5: "MODE",
+    6: "MARKER",
+}
+
+SOURCES = {0: "none", 1: "serial", 2: "websocket", 3: "http", 4: "udp"}
+
+COMMANDS = {
+    1: "getConfig",
+    2: "setPosition",
+    3: "calibrate",
+    4: "setAllPositions",
+    5: "centerAll",
+    6: "minAll",
+    7: "maxAll",
+    8: "setFrequency",
+    9: "saveSettings",
+    10: "calibration",
+    11: "working",
+    12: "setCurrentBudget",
+    13: "putConfig",
+    14: "trajStart",
+    15: "trajStop",
+    16: "udpPose",
+    17: "setFeet",
+}
+
+FAULTS = {1: "json_parse", 2: "wifi_connect", 3: "spiffs_mount", 4: "unknown_command",
+          5: "latency_slo"}
+
+
+def describe(kind, arg, value, aux):
+    if kind == 1:
+        return f"ch={arg} angle={value} pulse={aux}"
+    if kind == 2:
+        return f"ch={arg} pulse={value} i2c_us={aux}"
+    if kind == 3:
+        return f"src={SOURCES.get(arg, arg)} cmd={COMMANDS.get(value, value)}"
+    if kind == 4:
+        return f"src={SOURCES.get(arg, arg)} fault={FAULTS.get(value, value)} aux={aux}"
+    if kind == 5:
+        return "mode=" + ("calibration" if value else "working")
+    return f"arg={arg} value={value} aux={aux}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("file")
+    parser.add_argument("--csv", action="store_true", help="вывод в CSV")
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as f:
+        data = f.read()
+
+    if len(data) < HEADER.size:
+        sys.exit("файл слишком короткий")
+
+    magic, version, record_size, count, total, snap_us = HEADER.unpack_from(data)
+    if magic != b"QSFR":
+        sys.exit("неверная сигнатура")
+    if version != 1 or record_size != RECORD.size:
+        sys.exit(f"неподдерживаемый формат: версия {version}, запись {record_size} байт")
+
+    if args.csv:
+        print("seq,time_us,type,arg,value,aux")
+    else:
+        print(f"# записей: {count}, всего с запуска: {total}, снимок: {snap_us} мкс")
+
+    first = total - count
+    prev_us = None
+    offset = HEADER.size
+    for i in range(count):
+        if offset + RECORD.size > len(data):
+            print("# выгрузка оборвана", file=sys.stderr)
+            break
+        time_us, kind, arg, value, aux = RECORD.unpack_from(data, offset)
+        offset += RECORD.size
+
+        # Запись, перезаписанная во время выгрузки, нарушает порядок времени
+        overwritten = prev_us is not None and ((time_us - prev_us) & 0xFFFFFFFF) > 0x7FFFFFFF
+        prev_us = time_us
+
+        if args.csv:
+            print(f"{first + i},{time_us},{EVENT_TYPES.get(kind, kind)},{arg},{value},{aux}")
+        else:
+            mark = " (перезаписана)" if overwritten else ""
+            print(f"{first + i:8d} {time_us:12d} {EVENT_TYPES.get(kind, kind):<11} "
+                  f"{describe(kind, arg, value, aux)}{mark}")
+
+
+if __name__ == "__main__":
+    main()
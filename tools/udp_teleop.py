@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Отправка поз по UDP-каналу управления (см. src/UdpControlServer.h).
+
+Использование:
+    python3 tools/udp_teleop.py <ip> [--port 4210] [--token N] [--rate 50]
+                                [--loss 0.1] [--reorder 0.05] [--seconds 10]
+
+Все каналы плавно качаются вокруг 90°. Параметры --loss и --reorder
+выбрасывают и переставляют пакеты, чтобы проверить счетчики потерь
+(команда "udp" в Serial или поле udp в телеметрии WebSocket).
+"""
+
+import argparse
+import math
+import random
+import socket
+import struct
+import time
+
+HEADER = struct.Struct("<2sBBIIBB2x")
+PACKET_POSE = 1
+CHANNELS = 16
+
+
+def pose_packet(seq, session, token, t):
+    angle = int(round(90 + 30 * math.sin(2 * math.pi * t / 2.0)))
+    header = HEADER.pack(b"QS", 1, PACKET_POSE, seq & 0xFFFFFFFF, token, CHANNELS, session)
+    return header + bytes([angle] * CHANNELS)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host")
+    parser.add_argument("--port", type=int, default=4210)
+    parser.add_argument("--token", type=int, default=0)
+    parser.add_argument("--rate", type=float, default=50.0, help="пакетов в секунду")
+    parser.add_argument("--loss", type=float, default=0.0, help="доля выброшенных пакетов")
+    parser.add_argument("--reorder", type=float, default=0.0, help="доля переставленных пакетов")
+    parser.add_argument("--seconds", type=float, default=10.0)
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    period = 1.0 / args.rate
+    start = time.monotonic()
+    seq = 0
+    # Новый сеанс при каждом запуске: устройство начинает отсчет номеров заново
+    session = random.randint(1, 255)
+    held = None
+    sent = dropped = reordered = 0
+
+    while time.monotonic() - start < args.seconds:
+        seq += 1
+        packet = pose_packet(seq, session, args.token, time.monotonic() - start)
+
+        if random.random() < args.loss:
+            dropped += 1
+        elif held is None and random.random() < args.reorder:
+            # Придерживаем пакет и отправляем его после следующего
+            held = packet
+            reordered += 1
+        else:
+            sock.sendto(packet, (args.host, args.port))
+            sent += 1
+            if held is not None:
+                sock.sendto(held, (args.host, args.port))
+                sent += 1
+                held = None
+
+        time.sleep(period)
+
+    print(f"номеров: {seq}, отправлено: {sent}, выброшено: {dropped}, переставлено: {reordered}")
+
+
+if __name__ == "__main__":
+    main()